@@ -0,0 +1,79 @@
+#include "analysis/FrequencySweep.hpp"
+#include "parallel/ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+
+// Constructor using a grid of frequencies in hertz
+FrequencySweep::FrequencySweep(Circuit* circuit, std::vector<double> frequencies) 
+    : circuit(circuit), frequencies(std::move(frequencies)) {
+
+    for (double frequency : this->frequencies) {
+        if (frequency <= 0.0) {
+            throw std::runtime_error("Sweep frequencies must be positive!");
+        }
+    }
+}
+
+// Evenly spaced points between two frequencies
+std::vector<double> FrequencySweep::linearGrid(double startFrequency, double stopFrequency, int numPoints) {
+    std::vector<double> grid(std::max(numPoints, 0));
+    for (int point = 0; point < numPoints; point++) {
+        double ratio = numPoints > 1 ? static_cast<double>(point) / (numPoints - 1) : 0.0;
+        grid[point] = startFrequency + ratio * (stopFrequency - startFrequency);
+    }
+    return grid;
+}
+
+// Logarithmically spaced points between two frequencies
+std::vector<double> FrequencySweep::logGrid(double startFrequency, double stopFrequency, int numPoints) {
+    std::vector<double> grid = linearGrid(std::log10(startFrequency), std::log10(stopFrequency), numPoints);
+    for (double& value : grid) {
+        value = std::pow(10.0, value);
+    }
+    return grid;
+}
+
+// Stream the mesh currents of every point to a callback
+void FrequencySweep::run(const Callback& callback) const {
+    const CompiledCircuit compiled = circuit->compile();
+    int numBlocks = circuit->getPartition().getNumBlocks();
+    int numPoints = frequencies.size();
+    std::mutex callbackMutex;
+
+    // One slot per worker; each slot keeps its own solvers so the symbolic
+    // analysis of every block is done once per slot, and its own variant of
+    // the compiled circuit to hold the impedances of the current point
+    ThreadPool& pool = ThreadPool::shared();
+    int numSlots = std::min<int>(numPoints, pool.getNumThreads());
+
+    pool.parallelFor(numSlots, [&](int slot) {
+        std::vector<MeshSolver> solvers(numBlocks);
+        SolverWorkspace workspace;
+        CompiledCircuit variant = compiled;
+        std::vector<std::complex<double>> meshCurrents;
+
+        for (int point = slot; point < numPoints; point += numSlots) {
+            variant.gatherImpedancesAt(2 * PI * frequencies[point]);
+            circuit->solveVariant(variant, solvers, workspace, meshCurrents);
+
+            std::lock_guard<std::mutex> lock(callbackMutex);
+            callback(point, frequencies[point], meshCurrents);
+        }
+    });
+}
+
+// Collect the mesh currents of every point, one column per frequency
+Eigen::MatrixXcd FrequencySweep::run() const {
+    Eigen::MatrixXcd result(circuit->getMeshesView().size(), frequencies.size());
+    run([&result](int pointIndex, double, const std::vector<std::complex<double>>& meshCurrents) {
+        result.col(pointIndex) = Eigen::Map<const Eigen::VectorXcd>(meshCurrents.data(), meshCurrents.size());
+    });
+    return result;
+}
+
+// Getters
+const std::vector<double>& FrequencySweep::getFrequencies() const {
+    return frequencies;
+}
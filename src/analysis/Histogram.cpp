@@ -0,0 +1,69 @@
+#include "analysis/Histogram.hpp"
+#include <stdexcept>
+
+// Constructors
+Histogram::Histogram() 
+    : lower(0.0), upper(0.0), underflow(0), overflow(0) {}
+
+Histogram::Histogram(double lower, double upper, int numBins) 
+    : lower(lower), upper(upper), counts(numBins, 0), underflow(0), overflow(0) {
+
+    if (numBins <= 0 || !(upper > lower)) {
+        throw std::runtime_error("Histogram needs at least one bin and a non-empty range!");
+    }
+}
+
+// Add one value; the upper edge belongs to the last bin and NaN counts as underflow
+void Histogram::add(double value) {
+    if (!(value >= lower)) {
+        underflow++;
+        return;
+    }
+    if (value > upper) {
+        overflow++;
+        return;
+    }
+    int bin = static_cast<int>((value - lower) / (upper - lower) * counts.size());
+    counts[bin < static_cast<int>(counts.size()) ? bin : counts.size() - 1]++;
+}
+
+// Fold in the counts of a histogram with the same bins
+void Histogram::merge(const Histogram& other) {
+    if (other.lower != lower || other.upper != upper || other.counts.size() != counts.size()) {
+        throw std::runtime_error("Histograms with different bins cannot be merged!");
+    }
+    for (size_t bin = 0; bin < counts.size(); ++bin) {
+        counts[bin] += other.counts[bin];
+    }
+    underflow += other.underflow;
+    overflow += other.overflow;
+}
+
+// Getters
+double Histogram::getLower() const {
+    return lower;
+}
+
+double Histogram::getUpper() const {
+    return upper;
+}
+
+int Histogram::getNumBins() const {
+    return counts.size();
+}
+
+double Histogram::getBinWidth() const {
+    return counts.empty() ? 0.0 : (upper - lower) / counts.size();
+}
+
+const std::vector<long long>& Histogram::getCounts() const {
+    return counts;
+}
+
+long long Histogram::getUnderflow() const {
+    return underflow;
+}
+
+long long Histogram::getOverflow() const {
+    return overflow;
+}
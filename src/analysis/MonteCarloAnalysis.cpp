@@ -0,0 +1,191 @@
+#include "analysis/MonteCarloAnalysis.hpp"
+#include "load/components/Component.hpp"
+#include "parallel/ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+// Current through a load, oriented like the branches of Simulator: the current
+// of its last mesh minus that of its first mesh when the two differ
+static std::complex<double> loadCurrent(const CompiledCircuit& values, int loadIndex,
+                                        const std::vector<std::complex<double>>& meshCurrents) {
+    const int* loadMeshes = values.loadMeshesBegin(loadIndex);
+    int meshCount = values.loadMeshesEnd(loadIndex) - loadMeshes;
+    std::complex<double> current = meshCurrents[loadMeshes[meshCount - 1]];
+    if (meshCount == 2 && loadMeshes[0] != loadMeshes[1]) {
+        current -= meshCurrents[loadMeshes[0]];
+    }
+    return current;
+}
+
+// Normal deviation redrawn until it lies within three standard deviations
+static double truncatedNormal(std::normal_distribution<double>& normal, std::mt19937_64& engine) {
+    double deviation;
+    do {
+        deviation = normal(engine);
+    } while (std::abs(deviation) > 1.0);
+    return deviation;
+}
+
+// Histogram centered on a nominal value
+static Histogram histogramAround(double nominal, double relativeSpan, int numBins) {
+    double halfWidth = std::abs(nominal) * relativeSpan;
+    if (halfWidth == 0.0) {
+        halfWidth = 1.0;
+    }
+    return Histogram(nominal - halfWidth, nominal + halfWidth, numBins);
+}
+
+// Constructor
+MonteCarloAnalysis::MonteCarloAnalysis(Circuit* circuit, long long numSamples, std::uint64_t seed)
+    : circuit(circuit), numSamples(numSamples), seed(seed), distribution(Distribution::UNIFORM),
+      numBins(50), histogramSpan(0.5), numThreads(0) {
+
+    if (numSamples < 0) {
+        throw std::runtime_error("Monte Carlo sample count cannot be negative!");
+    }
+}
+
+// Draw every sample and accumulate the statistics of every load
+void MonteCarloAnalysis::run() {
+    const CompiledCircuit compiled = circuit->compile();
+    int numLoads = compiled.getNumLoads();
+    int numBlocks = circuit->getPartition().getNumBlocks();
+
+    // Components that vary; other loads keep their compiled impedance
+    std::vector<const Component*> components(numLoads, nullptr);
+    for (int loadIndex = 0; loadIndex < numLoads; loadIndex++) {
+        auto* component = dynamic_cast<const Component*>(compiled.getIncidence().getLoad(loadIndex));
+        if (component && component->getTolerance() > 0.0) {
+            components[loadIndex] = component;
+        }
+    }
+
+    // Loads in more than two meshes have no branch current
+    for (int loadIndex = 0; loadIndex < numLoads; loadIndex++) {
+        if (compiled.loadMeshesEnd(loadIndex) - compiled.loadMeshesBegin(loadIndex) > 2) {
+            throw std::runtime_error("Load shared by more than two meshes!");
+        }
+    }
+
+    // Histograms are centered on the nominal solution
+    std::vector<std::complex<double>> nominalCurrents = circuit->solveCompiled(compiled);
+    std::vector<LoadStatistics> empty(numLoads);
+    for (int loadIndex = 0; loadIndex < numLoads; loadIndex++) {
+        std::complex<double> current = loadCurrent(compiled, loadIndex, nominalCurrents);
+        double power = std::norm(current) * compiled.getImpedance(loadIndex).real();
+        empty[loadIndex].currentHistogram = histogramAround(std::abs(current), histogramSpan, numBins);
+        empty[loadIndex].powerHistogram = histogramAround(power, histogramSpan, numBins);
+    }
+
+    // One slot per worker, each with its own accumulators, solvers and variant
+    ThreadPool& pool = ThreadPool::shared();
+    long long numChunks = (numSamples + MONTE_CARLO_CHUNK_SIZE - 1) / MONTE_CARLO_CHUNK_SIZE;
+    int numWorkers = numThreads > 0 ? numThreads : static_cast<int>(pool.getNumThreads());
+    int numSlots = static_cast<int>(std::min<long long>(numChunks, numWorkers));
+    std::vector<std::vector<LoadStatistics>> slotStatistics(numSlots, empty);
+
+    pool.parallelFor(numSlots, [&](int slot) {
+        std::vector<LoadStatistics>& accumulators = slotStatistics[slot];
+        std::vector<MeshSolver> solvers(numBlocks);
+        SolverWorkspace workspace;
+        CompiledCircuit variant = compiled;
+        std::vector<std::complex<double>> meshCurrents;
+        std::mt19937_64 engine;
+        std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+        std::normal_distribution<double> normal(0.0, 1.0 / 3.0);
+
+        for (long long chunk = slot; chunk < numChunks; chunk += numSlots) {
+            // Every chunk has its own stream, whichever slot draws it
+            std::seed_seq sequence{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+                                   static_cast<std::uint32_t>(chunk), static_cast<std::uint32_t>(chunk >> 32)};
+            engine.seed(sequence);
+            normal.reset();
+            long long last = std::min(numSamples, (chunk + 1) * MONTE_CARLO_CHUNK_SIZE);
+
+            for (long long sample = chunk * MONTE_CARLO_CHUNK_SIZE; sample < last; sample++) {
+                for (int loadIndex = 0; loadIndex < numLoads; loadIndex++) {
+                    const Component* component = components[loadIndex];
+                    if (!component) {
+                        continue;
+                    }
+                    // |deviation| <= 1 and tolerance < 1, so the value keeps the sign of the nominal one
+                    double deviation = distribution == Distribution::UNIFORM ? uniform(engine) 
+                                                                             : truncatedNormal(normal, engine);
+                    double value = component->getComponentValue() * (1.0 + component->getTolerance() * deviation);
+                    variant.setImpedance(loadIndex, component->getImpedanceFor(value, component->getAngularFrequency()));
+                }
+
+                circuit->solveVariant(variant, solvers, workspace, meshCurrents);
+
+                for (int loadIndex = 0; loadIndex < numLoads; loadIndex++) {
+                    std::complex<double> current = loadCurrent(variant, loadIndex, meshCurrents);
+                    double magnitude = std::abs(current);
+                    double power = std::norm(current) * variant.getImpedance(loadIndex).real();
+                    LoadStatistics& load = accumulators[loadIndex];
+                    load.current.add(magnitude);
+                    load.power.add(power);
+                    load.currentHistogram.add(magnitude);
+                    load.powerHistogram.add(power);
+                }
+            }
+        }
+    });
+
+    // Combine the slots in a fixed order
+    statistics = std::move(empty);
+    for (const std::vector<LoadStatistics>& accumulators : slotStatistics) {
+        for (int loadIndex = 0; loadIndex < numLoads; loadIndex++) {
+            statistics[loadIndex].current.merge(accumulators[loadIndex].current);
+            statistics[loadIndex].power.merge(accumulators[loadIndex].power);
+            statistics[loadIndex].currentHistogram.merge(accumulators[loadIndex].currentHistogram);
+            statistics[loadIndex].powerHistogram.merge(accumulators[loadIndex].powerHistogram);
+        }
+    }
+}
+
+// Getters
+long long MonteCarloAnalysis::getNumSamples() const {
+    return numSamples;
+}
+
+int MonteCarloAnalysis::getNumThreads() const {
+    return numThreads;
+}
+
+MonteCarloAnalysis::Distribution MonteCarloAnalysis::getDistribution() const {
+    return distribution;
+}
+
+const std::vector<MonteCarloAnalysis::LoadStatistics>& MonteCarloAnalysis::getStatistics() const {
+    return statistics;
+}
+
+const MonteCarloAnalysis::LoadStatistics& MonteCarloAnalysis::getStatistics(Load* load) const {
+    int loadIndex = circuit->getLoadIncidence().findLoad(load);
+    if (loadIndex < 0 || loadIndex >= static_cast<int>(statistics.size())) {
+        throw std::runtime_error("Load has no Monte Carlo statistics!");
+    }
+    return statistics[loadIndex];
+}
+
+// Setters
+void MonteCarloAnalysis::setDistribution(Distribution newDistribution) {
+    distribution = newDistribution;
+}
+
+void MonteCarloAnalysis::setNumThreads(int newNumThreads) {
+    if (newNumThreads < 0) {
+        throw std::runtime_error("Thread count cannot be negative!");
+    }
+    numThreads = newNumThreads;
+}
+
+void MonteCarloAnalysis::setHistogram(int newNumBins, double relativeSpan) {
+    if (newNumBins <= 0 || relativeSpan <= 0.0) {
+        throw std::runtime_error("Histogram needs at least one bin and a positive span!");
+    }
+    numBins = newNumBins;
+    histogramSpan = relativeSpan;
+}
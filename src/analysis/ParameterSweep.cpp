@@ -0,0 +1,134 @@
+#include "analysis/ParameterSweep.hpp"
+#include "analysis/FrequencySweep.hpp"
+#include "parallel/ThreadPool.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+// Constructor
+ParameterSweep::ParameterSweep(Circuit* circuit, Combination combination)
+    : circuit(circuit), combination(combination) {}
+
+// Sweep the value of a component over a list of values
+void ParameterSweep::addParameter(Component* component, std::vector<double> values) {
+    for (const Parameter& parameter : parameters) {
+        if (parameter.component == component) {
+            throw std::runtime_error("Component is already swept!");
+        }
+    }
+    for (double value : values) {
+        if (value == 0.0) {
+            throw std::runtime_error("Component value cannot be zero!");
+        }
+    }
+    parameters.push_back({component, std::move(values)});
+}
+
+// Sweep it over evenly or logarithmically spaced values, both ends included
+void ParameterSweep::addLinearParameter(Component* component, double startValue, double stopValue, int numPoints) {
+    addParameter(component, FrequencySweep::linearGrid(startValue, stopValue, numPoints));
+}
+
+void ParameterSweep::addLogParameter(Component* component, double startValue, double stopValue, int numPoints) {
+    if (startValue <= 0.0 || stopValue <= 0.0) {
+        throw std::runtime_error("Logarithmic grids need positive values!");
+    }
+    addParameter(component, FrequencySweep::logGrid(startValue, stopValue, numPoints));
+}
+
+// Number of points for the current parameters and combination
+int ParameterSweep::getNumPoints() const {
+    if (parameters.empty()) {
+        return 0;
+    }
+    long long numPoints = combination == Combination::ZIP ? parameters[0].values.size() : 1;
+    for (const Parameter& parameter : parameters) {
+        if (combination == Combination::ZIP && parameter.values.size() != static_cast<size_t>(numPoints)) {
+            throw std::runtime_error("Zipped grids must have the same length!");
+        }
+        if (combination == Combination::CARTESIAN) {
+            numPoints *= parameter.values.size();
+        }
+    }
+    if (numPoints > std::numeric_limits<int>::max()) {
+        throw std::runtime_error("Too many sweep points!");
+    }
+    return static_cast<int>(numPoints);
+}
+
+// Solve every point
+void ParameterSweep::run() {
+    const CompiledCircuit compiled = circuit->compile();
+    int numBlocks = circuit->getPartition().getNumBlocks();
+    int numPoints = getNumPoints();
+    int numParameters = parameters.size();
+    int numMeshes = compiled.getNumMeshes();
+
+    // Load of every swept component
+    std::vector<int> loadIndices(numParameters);
+    for (int parameterIndex = 0; parameterIndex < numParameters; parameterIndex++) {
+        loadIndices[parameterIndex] = compiled.getIncidence().findLoad(parameters[parameterIndex].component);
+        if (loadIndices[parameterIndex] < 0) {
+            throw std::runtime_error("Swept component is not part of the circuit!");
+        }
+    }
+
+    // Value of every parameter at every point: a mixed-radix counter for the
+    // Cartesian product, the same index in every grid for a zip
+    parameterValues.resize(numPoints, numParameters);
+    for (int point = 0; point < numPoints; point++) {
+        int remainder = point;
+        for (int parameterIndex = numParameters - 1; parameterIndex >= 0; parameterIndex--) {
+            const std::vector<double>& values = parameters[parameterIndex].values;
+            int valueIndex = point;
+            if (combination == Combination::CARTESIAN) {
+                valueIndex = remainder % values.size();
+                remainder /= values.size();
+            }
+            parameterValues(point, parameterIndex) = values[valueIndex];
+        }
+    }
+    meshCurrents.resize(numPoints, numMeshes);
+
+    // One slot per worker; each slot keeps its solvers and variant across its points
+    ThreadPool& pool = ThreadPool::shared();
+    int numSlots = std::min<int>(numPoints, pool.getNumThreads());
+
+    pool.parallelFor(numSlots, [&](int slot) {
+        std::vector<MeshSolver> solvers(numBlocks);
+        SolverWorkspace workspace;
+        CompiledCircuit variant = compiled;
+        std::vector<std::complex<double>> pointCurrents;
+
+        for (int point = slot; point < numPoints; point += numSlots) {
+            for (int parameterIndex = 0; parameterIndex < numParameters; parameterIndex++) {
+                const Component* component = parameters[parameterIndex].component;
+                variant.setImpedance(loadIndices[parameterIndex],
+                                     component->getImpedanceFor(parameterValues(point, parameterIndex),
+                                                                component->getAngularFrequency()));
+            }
+
+            circuit->solveVariant(variant, solvers, workspace, pointCurrents);
+            for (int meshIndex = 0; meshIndex < numMeshes; meshIndex++) {
+                meshCurrents(point, meshIndex) = pointCurrents[meshIndex];
+            }
+        }
+    });
+}
+
+// Getters
+ParameterSweep::Combination ParameterSweep::getCombination() const {
+    return combination;
+}
+
+int ParameterSweep::getNumParameters() const {
+    return parameters.size();
+}
+
+const Eigen::MatrixXd& ParameterSweep::getParameterValues() const {
+    return parameterValues;
+}
+
+const Eigen::MatrixXcd& ParameterSweep::getMeshCurrents() const {
+    return meshCurrents;
+}
@@ -0,0 +1,58 @@
+#include "analysis/RunningStatistics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Constructor
+RunningStatistics::RunningStatistics() 
+    : count(0), mean(0.0), squaredDeviations(0.0), 
+      minimum(std::numeric_limits<double>::infinity()), maximum(-std::numeric_limits<double>::infinity()) {}
+
+// Add one value, updating the mean and the sum of squared deviations from it
+void RunningStatistics::add(double value) {
+    count++;
+    double delta = value - mean;
+    mean += delta / count;
+    squaredDeviations += delta * (value - mean);
+    minimum = std::min(minimum, value);
+    maximum = std::max(maximum, value);
+}
+
+// Fold in another accumulator (Chan et al. pairwise update)
+void RunningStatistics::merge(const RunningStatistics& other) {
+    if (other.count == 0) {
+        return;
+    }
+    long long total = count + other.count;
+    double delta = other.mean - mean;
+    mean += delta * other.count / total;
+    squaredDeviations += other.squaredDeviations + delta * delta * count * other.count / total;
+    count = total;
+    minimum = std::min(minimum, other.minimum);
+    maximum = std::max(maximum, other.maximum);
+}
+
+// Getters
+long long RunningStatistics::getCount() const {
+    return count;
+}
+
+double RunningStatistics::getMean() const {
+    return mean;
+}
+
+double RunningStatistics::getVariance() const {
+    return count > 1 ? squaredDeviations / (count - 1) : 0.0;
+}
+
+double RunningStatistics::getStandardDeviation() const {
+    return std::sqrt(getVariance());
+}
+
+double RunningStatistics::getMinimum() const {
+    return minimum;
+}
+
+double RunningStatistics::getMaximum() const {
+    return maximum;
+}
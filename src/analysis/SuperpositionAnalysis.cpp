@@ -0,0 +1,72 @@
+#include "analysis/SuperpositionAnalysis.hpp"
+#include "parallel/ThreadPool.hpp"
+#include <cmath>
+
+// Constructor
+SuperpositionAnalysis::SuperpositionAnalysis(Circuit* circuit) 
+    : circuit(circuit) {}
+
+// Solve the circuit once per source frequency, the frequencies in parallel
+void SuperpositionAnalysis::run() {
+    const CompiledCircuit compiled = circuit->compile();
+    int numBlocks = circuit->getPartition().getNumBlocks();
+    frequencies = compiled.getSourceFrequencies();
+    int numGroups = frequencies.size();
+    phasors = Eigen::MatrixXcd::Zero(compiled.getNumMeshes(), numGroups);
+
+    // Each group owns its variant of the compiled circuit, its solvers and its column.
+    // Loads open at a frequency, like capacitors at DC, are assembled as constraints.
+    ThreadPool::shared().parallelFor(numGroups, [&](int group) {
+        CompiledCircuit variant = compiled;
+        variant.gatherImpedancesAt(2 * PI * frequencies[group]);
+        variant.gatherSourcesOfFrequency(frequencies[group]);
+
+        std::vector<MeshSolver> solvers(numBlocks);
+        SolverWorkspace workspace;
+        std::vector<std::complex<double>> meshCurrents;
+        circuit->solveVariant(variant, solvers, workspace, meshCurrents);
+        for (int meshIndex = 0; meshIndex < compiled.getNumMeshes(); meshIndex++) {
+            phasors(meshIndex, group) = meshCurrents[meshIndex];
+        }
+    });
+}
+
+// Instantaneous mesh currents: Re(I * e^(jwt)) summed over the frequencies
+std::vector<double> SuperpositionAnalysis::getMeshCurrentsAt(double time) const {
+    Eigen::MatrixXd currents = getMeshCurrentsAt(std::vector<double>{time});
+    return std::vector<double>(currents.data(), currents.data() + currents.size());
+}
+
+Eigen::MatrixXd SuperpositionAnalysis::getMeshCurrentsAt(const std::vector<double>& times) const {
+    Eigen::MatrixXd currents = Eigen::MatrixXd::Zero(phasors.rows(), times.size());
+    for (size_t point = 0; point < times.size(); ++point) {
+        for (size_t group = 0; group < frequencies.size(); ++group) {
+            std::complex<double> rotation = std::polar(1.0, 2 * PI * frequencies[group] * times[point]);
+            currents.col(point) += (phasors.col(group) * rotation).real();
+        }
+    }
+    return currents;
+}
+
+// RMS value of every mesh current: DC adds its square, each sinusoid half its peak squared
+std::vector<double> SuperpositionAnalysis::getRmsCurrents() const {
+    std::vector<double> rms(phasors.rows(), 0.0);
+    for (int meshIndex = 0; meshIndex < phasors.rows(); meshIndex++) {
+        double power = 0.0;
+        for (size_t group = 0; group < frequencies.size(); ++group) {
+            std::complex<double> phasor = phasors(meshIndex, group);
+            power += frequencies[group] == 0.0 ? phasor.real() * phasor.real() : std::norm(phasor) / 2;
+        }
+        rms[meshIndex] = std::sqrt(power);
+    }
+    return rms;
+}
+
+// Getters
+const std::vector<double>& SuperpositionAnalysis::getFrequencies() const {
+    return frequencies;
+}
+
+const Eigen::MatrixXcd& SuperpositionAnalysis::getPhasors() const {
+    return phasors;
+}
@@ -0,0 +1,130 @@
+#include "analysis/TransientAnalysis.hpp"
+#include <stdexcept>
+
+// Constructor using a step in seconds and the number of steps after time zero
+TransientAnalysis::TransientAnalysis(Circuit* circuit, double timeStep, int numSteps, IntegrationMethod method)
+    : circuit(circuit), timeStep(timeStep), numSteps(numSteps), method(method) {
+
+    if (timeStep <= 0.0) {
+        throw std::runtime_error("Transient time step must be positive!");
+    }
+    if (numSteps < 0) {
+        throw std::runtime_error("Transient step count cannot be negative!");
+    }
+}
+
+// Stream the mesh currents of every step to a callback
+void TransientAnalysis::run(const Callback& callback) const {
+    CompiledCircuit variant = circuit->compile();
+    const MeshPartition& partition = circuit->getPartition();
+    int numMeshes = variant.getNumMeshes();
+    int numLoads = variant.getNumLoads();
+    int numBlocks = partition.getNumBlocks();
+
+    // Companion model of every load; their resistances replace the impedances
+    std::vector<CompanionModel> models(numLoads);
+    for (int loadIndex = 0; loadIndex < numLoads; loadIndex++) {
+        const int* loadMeshes = variant.loadMeshesBegin(loadIndex);
+        int meshCount = variant.loadMeshesEnd(loadIndex) - loadMeshes;
+        if (meshCount > 2 || (meshCount == 2 && loadMeshes[0] == loadMeshes[1])) {
+            throw std::runtime_error("Transient analysis needs every load in at most two meshes!");
+        }
+        models[loadIndex] = variant.getIncidence().getLoad(loadIndex)->getCompanionModel(timeStep, method);
+        variant.setImpedance(loadIndex, models[loadIndex].resistance);
+    }
+
+    // The companion system does not change between steps: factor every block once
+    std::vector<RealMeshSolver> solvers(numBlocks);
+    std::vector<Eigen::VectorXd> blockVoltages(numBlocks);
+    std::vector<Eigen::VectorXd> blockCurrents(numBlocks);
+    std::vector<Eigen::Triplet<double>> triplets;
+    Eigen::VectorXcd voltageVector;
+    for (int blockIndex = 0; blockIndex < numBlocks; blockIndex++) {
+        circuit->assembleBlock(variant, blockIndex, triplets, voltageVector);
+        solvers[blockIndex].prepare(triplets, voltageVector.size(), circuit->getSolverMode());
+        blockVoltages[blockIndex].resize(voltageVector.size());
+    }
+
+    // Branch current and voltage of every load, oriented along its first mesh
+    std::vector<double> branchCurrents(numLoads, 0.0);
+    std::vector<double> branchVoltages(numLoads, 0.0);
+    std::vector<double> historyVoltages(numLoads);
+    std::vector<double> meshVoltages(numMeshes);
+    std::vector<double> meshCurrents(numMeshes, 0.0);
+    callback(0, 0.0, meshCurrents);
+
+    for (int step = 1; step <= numSteps; step++) {
+        double time = step * timeStep;
+        variant.gatherSourcesAt(time);
+        for (int meshIndex = 0; meshIndex < numMeshes; meshIndex++) {
+            meshVoltages[meshIndex] = variant.getMeshVoltage(meshIndex).real();
+        }
+
+        // The history term of each load moves to the right-hand side of its meshes
+        for (int loadIndex = 0; loadIndex < numLoads; loadIndex++) {
+            const CompanionModel& model = models[loadIndex];
+            double history = model.currentGain * branchCurrents[loadIndex]
+                           + model.voltageGain * branchVoltages[loadIndex];
+            historyVoltages[loadIndex] = history;
+
+            const int* loadMeshes = variant.loadMeshesBegin(loadIndex);
+            meshVoltages[loadMeshes[0]] -= history;
+            if (variant.loadMeshesEnd(loadIndex) - loadMeshes == 2) {
+                meshVoltages[loadMeshes[1]] += history;
+            }
+        }
+
+        // Only a solve against the cached factorization per block
+        for (int blockIndex = 0; blockIndex < numBlocks; blockIndex++) {
+            const MeshPartition::Block& block = partition.getBlock(blockIndex);
+            Eigen::VectorXd& rhs = blockVoltages[blockIndex];
+            int numBlockMeshes = block.meshes.size();
+            for (int local = 0; local < numBlockMeshes; local++) {
+                rhs(local) = meshVoltages[block.meshes[local]];
+            }
+            for (size_t constraint = 0; constraint < block.currentSources.size(); ++constraint) {
+                rhs(numBlockMeshes + constraint) = variant.getCurrentSourceValue(block.currentSources[constraint]).real();
+            }
+
+            solvers[blockIndex].solve(rhs, blockCurrents[blockIndex]);
+            for (int local = 0; local < numBlockMeshes; local++) {
+                meshCurrents[block.meshes[local]] = blockCurrents[blockIndex](local);
+            }
+        }
+
+        // Advance the state of every load
+        for (int loadIndex = 0; loadIndex < numLoads; loadIndex++) {
+            const int* loadMeshes = variant.loadMeshesBegin(loadIndex);
+            double current = meshCurrents[loadMeshes[0]];
+            if (variant.loadMeshesEnd(loadIndex) - loadMeshes == 2) {
+                current -= meshCurrents[loadMeshes[1]];
+            }
+            branchCurrents[loadIndex] = current;
+            branchVoltages[loadIndex] = models[loadIndex].resistance * current + historyVoltages[loadIndex];
+        }
+
+        callback(step, time, meshCurrents);
+    }
+}
+
+// Collect the mesh currents of every step, one column per point in time
+Eigen::MatrixXd TransientAnalysis::run() const {
+    Eigen::MatrixXd result(circuit->getMeshesView().size(), numSteps + 1);
+    run([&result](int stepIndex, double, const std::vector<double>& meshCurrents) {
+        result.col(stepIndex) = Eigen::Map<const Eigen::VectorXd>(meshCurrents.data(), meshCurrents.size());
+    });
+    return result;
+}
+
+// Getters
+double TransientAnalysis::getTimeStep() const {
+    return timeStep;
+}
+
+int TransientAnalysis::getNumSteps() const {
+    return numSteps;
+}
+
+IntegrationMethod TransientAnalysis::getMethod() const {
+    return method;
+}
@@ -0,0 +1,18 @@
+#ifndef BENCHMARKCIRCUITS_HPP
+#define BENCHMARKCIRCUITS_HPP
+
+#include "../test/TestCircuits.hpp"
+#include <chrono>
+
+// Mean wall time of one call in microseconds
+template <typename Task>
+double timeMicroseconds(Task&& task, int repetitions) {
+    auto start = std::chrono::steady_clock::now();
+    for (int repetition = 0; repetition < repetitions; repetition++) {
+        task();
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / repetitions;
+}
+
+#endif // BENCHMARKCIRCUITS_HPP
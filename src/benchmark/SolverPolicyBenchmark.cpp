@@ -0,0 +1,51 @@
+// Benchmark includes
+#include "BenchmarkCircuits.hpp"
+#include "solver/SolverPolicy.hpp"
+// General C++ includes
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+// Refactor and solve grid circuits with every factorization the policy can
+// pick, and with the policy itself. Each iteration nudges one impedance so
+// the cached factorization cannot be reused. The error column is the largest
+// difference from the QR solution.
+int main() {
+    const SolverKind kinds[] = {SolverKind::DENSE_QR, SolverKind::DENSE_LU, SolverKind::DENSE_LDLT,
+                                SolverKind::SPARSE, SolverKind::AUTO};
+    std::cout << std::setw(6) << "size";
+    for (SolverKind kind : kinds) {
+        std::cout << std::setw(14) << SolverPolicy::getName(kind) << std::setw(10) << "error";
+    }
+    std::cout << std::endl;
+
+    for (int width : {2, 3, 4, 5, 6, 8, 10, 14, 20}) {
+        int repetitions = width < 8 ? 2000 : (width < 15 ? 100 : 10);
+        std::vector<std::complex<double>> reference;
+        std::cout << std::setw(6) << width * width;
+
+        for (SolverKind kind : kinds) {
+            CircuitBuilder builder;
+            Circuit* circuit = buildGrid(builder, width);
+            circuit->setSolverMode(kind);
+            Load* load = circuit->getLoadIncidence().getLoad(0);
+            double time = timeMicroseconds([&] {
+                load->setImpedance(load->getImpedance() * 1.0000001);
+                circuit->solveMeshCurrents();
+            }, repetitions);
+
+            std::vector<std::complex<double>> currents = circuit->getMeshCurrents();
+            if (reference.empty()) {
+                reference = currents;
+            }
+            double error = 0.0;
+            for (size_t index = 0; index < currents.size(); ++index) {
+                error = std::max(error, std::abs(currents[index] - reference[index]));
+            }
+            std::cout << std::fixed << std::setprecision(1) << std::setw(12) << time << "us"
+                      << std::scientific << std::setw(10) << error;
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
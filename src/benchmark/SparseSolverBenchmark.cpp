@@ -0,0 +1,42 @@
+// Benchmark includes
+#include "BenchmarkCircuits.hpp"
+// General C++ includes
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+// Assemble and solve grid circuits with the dense column-pivoting QR and with
+// sparse LU, to place the crossover behind SPARSE_SOLVER_THRESHOLD. Each
+// iteration nudges one impedance so every solve assembles and factors again.
+int main() {
+    std::cout << std::setw(8) << "meshes" << std::setw(14) << "dense QR" << std::setw(14) << "sparse LU"
+              << std::setw(12) << "difference" << std::endl;
+
+    for (int width : {3, 4, 5, 6, 8, 10, 14, 20, 30}) {
+        int repetitions = width < 10 ? 2000 : (width < 20 ? 20 : 2);
+        double times[2];
+        std::vector<std::complex<double>> currents[2];
+        const SolverKind kinds[] = {SolverKind::DENSE_QR, SolverKind::SPARSE};
+
+        for (int index = 0; index < 2; index++) {
+            CircuitBuilder builder;
+            Circuit* circuit = buildGrid(builder, width);
+            circuit->setSolverMode(kinds[index]);
+            Load* load = circuit->getLoadIncidence().getLoad(0);
+            times[index] = timeMicroseconds([&] {
+                load->setImpedance(load->getImpedance() * 1.0000001);
+                circuit->solveMeshCurrents();
+            }, repetitions);
+            currents[index] = circuit->getMeshCurrents();
+        }
+
+        double difference = 0.0;
+        for (size_t mesh = 0; mesh < currents[0].size(); ++mesh) {
+            difference = std::max(difference, std::abs(currents[0][mesh] - currents[1][mesh]));
+        }
+        std::cout << std::fixed << std::setprecision(1) << std::setw(8) << width * width 
+                  << std::setw(12) << times[0] << "us" << std::setw(12) << times[1] << "us" 
+                  << std::scientific << std::setw(12) << difference << std::endl;
+    }
+    return 0;
+}
@@ -1,9 +1,15 @@
 #include "circuit/Circuit.hpp"
+#include "parallel/ThreadPool.hpp"
+#include "solver/FixedSizeSolver.hpp"
+#include <cmath>
+#include <stdexcept>
 
 // Constructor using member initializer list
-Circuit::Circuit() : meshes({}) {}
+Circuit::Circuit() 
+    : meshes({}), solverMode(SolverMode::AUTO), parallelSolve(true), topologySignature(0) {}
 
-Circuit::Circuit(std::vector<Mesh*> meshes) : meshes(std::move(meshes)) {}
+Circuit::Circuit(std::vector<Mesh*> meshes) 
+    : meshes(std::move(meshes)), solverMode(SolverMode::AUTO), parallelSolve(true), topologySignature(0) {}
 
 // Add a mesh to the circuit
 void Circuit::addMesh(Mesh* mesh) {
@@ -19,70 +25,670 @@ std::vector<std::complex<double>> Circuit::getMeshCurrents() const {
     return this->meshCurrents;
 }
 
-std::unordered_map<ACCurrentSource*, std::vector<int>> Circuit::mapCurrentSourcesToMeshes() const {
-    std::unordered_map<ACCurrentSource*, std::vector<int>> sourceToMeshesMap;
-    for (int i = 0; i < meshes.size(); i++) {
-        for (const auto& source : meshes[i]->getSources()) {
-            if (auto currentSource = dynamic_cast<ACCurrentSource*>(source)) {
-                sourceToMeshesMap[currentSource].push_back(i);
+Span<Mesh* const> Circuit::getMeshesView() const {
+    return this->meshes;
+}
+
+Span<const std::complex<double>> Circuit::getMeshCurrentsView() const {
+    return this->meshCurrents;
+}
+
+Circuit::SolverMode Circuit::getSolverMode() const {
+    return this->solverMode;
+}
+
+bool Circuit::getParallelSolve() const {
+    return this->parallelSolve;
+}
+
+const LoadIncidence& Circuit::getLoadIncidence() {
+    refreshTopology();
+    return this->compiled.getIncidence();
+}
+
+const MeshPartition& Circuit::getPartition() {
+    refreshTopology();
+    return this->partition;
+}
+
+const MeshSolver& Circuit::getBlockSolver(int blockIndex) const {
+    return *this->blockSolvers.at(blockIndex);
+}
+
+const RealMeshSolver& Circuit::getRealBlockSolver(int blockIndex) const {
+    return *this->realBlockSolvers.at(blockIndex);
+}
+
+bool Circuit::isRealBlock(int blockIndex) const {
+    return this->realBlocks.at(blockIndex);
+}
+
+// Setters
+void Circuit::setSolverMode(SolverMode mode) {
+    this->solverMode = mode;
+}
+
+void Circuit::setParallelSolve(bool enabled) {
+    this->parallelSolve = enabled;
+}
+
+void Circuit::setMeshCurrents(Span<const std::complex<double>> currents) {
+    if (currents.size() != meshes.size()) {
+        throw std::runtime_error("Mesh current count does not match the circuit!");
+    }
+    this->meshCurrents.assign(currents.begin(), currents.end());
+}
+
+// Rebuild the compiled topology if any mesh changed since the last build.
+// Revisions only grow, so the mesh count plus their sum identifies the topology.
+void Circuit::refreshTopology() {
+    std::size_t signature = meshes.size() + 1;
+    for (const Mesh* mesh : meshes) {
+        signature += mesh->getRevision();
+    }
+    if (signature == topologySignature) {
+        return;
+    }
+
+    compiled = CompiledCircuit(meshes);
+    partition.build(compiled);
+    blockSolvers.clear();
+    realBlockSolvers.clear();
+    for (int blockIndex = 0; blockIndex < partition.getNumBlocks(); blockIndex++) {
+        blockSolvers.push_back(std::make_unique<MeshSolver>());
+        realBlockSolvers.push_back(std::make_unique<RealMeshSolver>());
+    }
+    realBlocks.assign(partition.getNumBlocks(), false);
+    workspaces.assign(partition.getNumBlocks(), SolverWorkspace());
+    topologySignature = signature;
+}
+
+std::unordered_map<Source*, std::vector<int>> Circuit::mapCurrentSourcesToMeshes() const {
+    std::unordered_map<Source*, std::vector<int>> sourceToMeshesMap;
+    int numMeshes = meshes.size();
+    for (int i = 0; i < numMeshes; i++) {
+        for (const auto& source : meshes[i]->getSourcesView()) {
+            if (source->isCurrentSource()) {
+                sourceToMeshesMap[source].push_back(i);
             }
         }
     }
     return sourceToMeshesMap;
 }
 
-// Use linear algebra to calculate mesh currents
-void Circuit::solveMeshCurrents() {
-    int numMeshes = meshes.size();
-    auto currentSourcesMap = mapCurrentSourcesToMeshes();
-    int numCurrentSources = currentSourcesMap.size();
-    int matrixSize = numMeshes + numCurrentSources;
+// Keep the real part of an impedance for resistive systems
+template <typename Scalar>
+static Scalar toScalar(std::complex<double> value);
 
-    // Adjust the size of the matrix and vector to include current sources
-    Eigen::MatrixXcd impedanceMatrix = Eigen::MatrixXcd::Zero(matrixSize, matrixSize);
-    Eigen::VectorXcd voltageVector(matrixSize);
+template <>
+double toScalar<double>(std::complex<double> value) {
+    return value.real();
+}
+
+template <>
+std::complex<double> toScalar<std::complex<double>>(std::complex<double> value) {
+    return value;
+}
 
-    // Fill matrices impedanceMatrix and B using KVL
+// Fill the system of one block: one KVL row per mesh, one constraint row per current source
+// and one per independent open load (see getOpenConstraints), whose branch current is held
+// at zero like a switched-off current source. The voltage across each of them is an extra unknown placed after the mesh currents.
+// Rows and columns use the local mesh indices of the block. Entries go to addEntry(row, column,
+// value), possibly several times for the same position, and voltages must be zeroed.
+template <typename Scalar, typename Sink>
+void Circuit::assembleBlockWith(const CompiledCircuit& values, int blockIndex, Sink&& addEntry, 
+                                std::complex<double>* voltages) const {
+    const MeshPartition::Block& block = partition.getBlock(blockIndex);
+    int numMeshes = block.meshes.size();
+
+    // Diagonal terms and voltages using KVL; the explicit zero keeps the
+    // diagonal in the pattern even for meshes without loads
     for (int row = 0; row < numMeshes; row++) {
-        Mesh* mesh = meshes[row];
-        std::unordered_set<Load*> meshLoads(mesh->getLoads().begin(), mesh->getLoads().end());
-
-        // Handle voltage sources
-        for (int column = 0; column < numMeshes; column++) {
-            if (row == column) {
-                impedanceMatrix(row, column) = mesh->calculateMeshImpedance();  
-            } else {
-                std::complex<double> totalCommonImpedance = 0.0;
-                for (Load* load : meshes[column]->getLoads()) {
-                    if (meshLoads.find(load) != meshLoads.end()) {
-                        totalCommonImpedance += load->getImpedance();
-                    }
+        addEntry(row, row, Scalar(0));
+        voltages[row] = values.getMeshVoltage(block.meshes[row]);
+    }
+
+    // Each load adds its impedance to the diagonal of every mesh holding it
+    // and subtracts it from the mutual term of every pair of those meshes
+    for (int loadIndex : block.loads) {
+        if (values.isOpen(loadIndex)) {
+            continue;
+        }
+        Scalar impedance = toScalar<Scalar>(values.getImpedance(loadIndex));
+        const int* first = values.loadMeshesBegin(loadIndex);
+        const int* last = values.loadMeshesEnd(loadIndex);
+        for (const int* row = first; row != last; ++row) {
+            int localRow = partition.getLocalIndex(*row);
+            addEntry(localRow, localRow, impedance);
+            for (const int* column = row + 1; column != last; ++column) {
+                if (*row != *column) {
+                    int localColumn = partition.getLocalIndex(*column);
+                    addEntry(localRow, localColumn, -impedance);
+                    addEntry(localColumn, localRow, -impedance);
                 }
-                impedanceMatrix(row, column) = -totalCommonImpedance;
             }
         }
-        voltageVector(row) = mesh->calculateMeshVoltage();  
     }
 
     // Handle current sources
     int rowIndex = numMeshes;
-    for (const auto& [currentSource, meshIndices] : currentSourcesMap) {
+    for (int sourceIndex : block.currentSources) {
+        int firstMesh = partition.getLocalIndex(values.getConstraintMesh(sourceIndex, 0));
+        // Source voltage enters the KVL of its meshes with opposite signs
+        addEntry(firstMesh, rowIndex, Scalar(1));
+        addEntry(rowIndex, firstMesh, Scalar(1));
         // Current source between two meshes
-        if (meshIndices.size() == 2) { 
-            impedanceMatrix(rowIndex, meshIndices[0]) = 1;
-            impedanceMatrix(rowIndex, meshIndices[1]) = -1;
-            voltageVector(rowIndex) = currentSource->getValue();
-            rowIndex++;
-        }
-        // For the voltage of the current source
-        impedanceMatrix(rowIndex, rowIndex) = 1;
-        voltageVector(rowIndex) = 0;
+        if (values.getConstraintMesh(sourceIndex, 1) >= 0) { 
+            int secondMesh = partition.getLocalIndex(values.getConstraintMesh(sourceIndex, 1));
+            addEntry(secondMesh, rowIndex, Scalar(-1));
+            addEntry(rowIndex, secondMesh, Scalar(-1));
+        }
+        voltages[rowIndex] = values.getCurrentSourceValue(sourceIndex);
         rowIndex++;
     }
 
-    // Solve the system of equations
-    Eigen::VectorXcd solutionVector = impedanceMatrix.colPivHouseholderQr().solve(voltageVector);
+    // Handle open loads, oriented like Simulator: last mesh minus first mesh
+    for (int loadIndex : getOpenConstraints(values, blockIndex)) {
+        const int* loadMeshes = values.loadMeshesBegin(loadIndex);
+        int meshCount = values.loadMeshesEnd(loadIndex) - loadMeshes;
+        int lastMesh = partition.getLocalIndex(loadMeshes[meshCount - 1]);
+        addEntry(lastMesh, rowIndex, Scalar(1));
+        addEntry(rowIndex, lastMesh, Scalar(1));
+        if (meshCount == 2) {
+            int firstMesh = partition.getLocalIndex(loadMeshes[0]);
+            addEntry(firstMesh, rowIndex, Scalar(-1));
+            addEntry(rowIndex, firstMesh, Scalar(-1));
+        }
+        rowIndex++;
+    }
+}
+
+// Open loads of a block that need a constraint row. Like a current source row, each
+// ties the currents of its two meshes, or of its mesh and the outside. An open load
+// closing a loop of such ties, like the second of two capacitors in series at DC, adds
+// nothing but a dependent row that would make the system singular, so a union-find over
+// the block meshes keeps only the open loads joining two groups not yet tied together.
+std::vector<int> Circuit::getOpenConstraints(const CompiledCircuit& values, int blockIndex) const {
+    const MeshPartition::Block& block = partition.getBlock(blockIndex);
+    std::vector<int> openLoads;
+    bool hasOpenLoad = false;
+    for (int loadIndex : block.loads) {
+        hasOpenLoad = hasOpenLoad || values.isOpen(loadIndex);
+    }
+    if (!hasOpenLoad) {
+        return openLoads;
+    }
+
+    // One group per local mesh, the last one standing for the outside
+    int outside = block.meshes.size();
+    std::vector<int> parents(outside + 1);
+    for (int node = 0; node <= outside; node++) {
+        parents[node] = node;
+    }
+    auto findRoot = [&parents](int node) {
+        while (parents[node] != node) {
+            parents[node] = parents[parents[node]];
+            node = parents[node];
+        }
+        return node;
+    };
+    // Joins the groups of two nodes; false if they already were one
+    auto join = [&findRoot, &parents](int first, int second) {
+        first = findRoot(first);
+        second = findRoot(second);
+        parents[first] = second;
+        return first != second;
+    };
+
+    for (int sourceIndex : block.currentSources) {
+        int secondMesh = values.getConstraintMesh(sourceIndex, 1);
+        join(partition.getLocalIndex(values.getConstraintMesh(sourceIndex, 0)),
+             secondMesh >= 0 ? partition.getLocalIndex(secondMesh) : outside);
+    }
+    for (int loadIndex : block.loads) {
+        if (!values.isOpen(loadIndex)) {
+            continue;
+        }
+        const int* loadMeshes = values.loadMeshesBegin(loadIndex);
+        int meshCount = values.loadMeshesEnd(loadIndex) - loadMeshes;
+        if (meshCount > 2) {
+            throw std::runtime_error("Open load shared by more than two meshes!");
+        }
+        if (join(partition.getLocalIndex(loadMeshes[0]),
+                 meshCount == 2 ? partition.getLocalIndex(loadMeshes[1]) : outside)) {
+            openLoads.push_back(loadIndex);
+        }
+    }
+    return openLoads;
+}
+
+// Fill the system of one block as triplets in real or complex arithmetic
+template <typename Scalar>
+void Circuit::assembleBlockAs(const CompiledCircuit& values, int blockIndex, 
+                              std::vector<Eigen::Triplet<Scalar>>& triplets, Eigen::VectorXcd& voltageVector) const {
+    triplets.clear();
+    voltageVector = Eigen::VectorXcd::Zero(getBlockSize(values, blockIndex));
+    assembleBlockWith<Scalar>(values, blockIndex, [&triplets](int row, int column, Scalar value) {
+        triplets.emplace_back(row, column, value);
+    }, voltageVector.data());
+}
+
+// Solve a block of at most FIXED_SIZE_SOLVER_LIMIT unknowns. The system is assembled
+// into stack arrays and handed to the fixed-size kernel of its size: no heap at all
+// unless the block has open loads to reduce.
+// Returns false without touching currents when the kernel rejects the system.
+template <typename Scalar, int Columns>
+bool Circuit::solveSmallBlockAs(const CompiledCircuit& values, int blockIndex, 
+                                std::vector<std::complex<double>>& currents) {
+    int size = getBlockSize(values, blockIndex);
+    Scalar matrix[FIXED_SIZE_SOLVER_LIMIT * FIXED_SIZE_SOLVER_LIMIT] = {};
+    std::complex<double> voltages[FIXED_SIZE_SOLVER_LIMIT] = {};
+    assembleBlockWith<Scalar>(values, blockIndex, [&matrix, size](int row, int column, Scalar value) {
+        matrix[column * size + row] += value;
+    }, voltages);
+
+    // Real systems carry the real and imaginary parts of the sources as two columns
+    Scalar solution[FIXED_SIZE_SOLVER_LIMIT * Columns];
+    for (int row = 0; row < size; row++) {
+        solution[row] = toScalar<Scalar>(voltages[row]);
+        if (Columns == 2) {
+            solution[size + row] = voltages[row].imag();
+        }
+    }
+    if (!FixedSizeSolver<Scalar, Columns>::solve(size, matrix, solution)) {
+        return false;
+    }
+
+    const std::vector<int>& blockMeshes = partition.getBlock(blockIndex).meshes;
+    for (size_t local = 0; local < blockMeshes.size(); ++local) {
+        currents[blockMeshes[local]] = Columns == 2 ? std::complex<double>(std::real(solution[local]), 
+                                                                           std::real(solution[size + local])) 
+                                                    : std::complex<double>(solution[local]);
+    }
+    return true;
+}
+
+// Solve a small block in real or complex arithmetic
+bool Circuit::solveSmallBlock(const CompiledCircuit& values, int blockIndex, 
+                              std::vector<std::complex<double>>& currents) {
+    realBlocks[blockIndex] = isResistiveBlock(values, blockIndex);
+    if (realBlocks[blockIndex]) {
+        return solveSmallBlockAs<double, 2>(values, blockIndex, currents);
+    }
+    return solveSmallBlockAs<std::complex<double>, 1>(values, blockIndex, currents);
+}
+
+// Whether a block goes through the fixed-size kernels; forcing a factorization opts out
+bool Circuit::usesFixedSizeSolver(const CompiledCircuit& values, int blockIndex) const {
+    return (solverMode == SolverMode::AUTO || solverMode == SolverMode::DENSE) 
+        && FixedSizeSolver<double, 2>::supports(getBlockSize(values, blockIndex));
+}
+
+// Number of unknowns of a block with the open loads of a compiled circuit
+int Circuit::getBlockSize(const CompiledCircuit& values, int blockIndex) const {
+    const MeshPartition::Block& block = partition.getBlock(blockIndex);
+    int size = block.meshes.size() + block.currentSources.size();
+    return size + getOpenConstraints(values, blockIndex).size();
+}
+
+// Fill the complex system of one block from the values of a compiled circuit
+void Circuit::assembleBlock(const CompiledCircuit& values, int blockIndex, 
+                            std::vector<Eigen::Triplet<std::complex<double>>>& triplets, 
+                            Eigen::VectorXcd& voltageVector) const {
+    assembleBlockAs<std::complex<double>>(values, blockIndex, triplets, voltageVector);
+}
+
+// Fill the real system of one block, keeping only the resistance of every impedance
+void Circuit::assembleBlock(const CompiledCircuit& values, int blockIndex, 
+                            std::vector<Eigen::Triplet<double>>& triplets, 
+                            Eigen::VectorXcd& voltageVector) const {
+    assembleBlockAs<double>(values, blockIndex, triplets, voltageVector);
+}
+
+// Whether every load of a block has a purely real impedance
+bool Circuit::isResistiveBlock(const CompiledCircuit& values, int blockIndex) const {
+    for (int loadIndex : partition.getBlock(blockIndex).loads) {
+        if (!values.isOpen(loadIndex) && values.getImpedance(loadIndex).imag() != 0.0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Assemble a block into its workspace and bring its persistent solver up to date.
+// Resistive blocks use real arithmetic: a quarter of the flops and half the memory.
+void Circuit::prepareBlock(const CompiledCircuit& values, int blockIndex) {
+    SolverWorkspace& workspace = workspaces[blockIndex];
+    realBlocks[blockIndex] = isResistiveBlock(values, blockIndex);
 
-    // Update the meshCurrents field
-    meshCurrents.assign(solutionVector.data(), solutionVector.data() + numMeshes);
+    // Reuse whichever cached phases are still valid
+    if (realBlocks[blockIndex]) {
+        assembleBlockAs<double>(values, blockIndex, workspace.realTriplets, workspace.voltageVector);
+        realBlockSolvers[blockIndex]->prepare(workspace.realTriplets, workspace.voltageVector.size(), solverMode);
+    } else {
+        assembleBlockAs<std::complex<double>>(values, blockIndex, workspace.complexTriplets, workspace.voltageVector);
+        blockSolvers[blockIndex]->prepare(workspace.complexTriplets, workspace.voltageVector.size(), solverMode);
+    }
+}
+
+// Solve a prepared block. A real system with complex sources (AC phasors on
+// resistors) solves the real and imaginary parts as separate columns.
+Eigen::MatrixXcd Circuit::solveBlock(int blockIndex, const Eigen::MatrixXcd& rhs) const {
+    if (!realBlocks[blockIndex]) {
+        return blockSolvers[blockIndex]->solve(rhs);
+    }
+
+    const RealMeshSolver& solver = *realBlockSolvers[blockIndex];
+    if (rhs.imag().isZero(0.0)) {
+        return solver.solve(Eigen::MatrixXd(rhs.real())).cast<std::complex<double>>();
+    }
+    int numColumns = rhs.cols();
+    Eigen::MatrixXd parts(rhs.rows(), 2 * numColumns);
+    parts << rhs.real(), rhs.imag();
+    Eigen::MatrixXd solution = solver.solve(parts);
+
+    Eigen::MatrixXcd result(rhs.rows(), numColumns);
+    result.real() = solution.leftCols(numColumns);
+    result.imag() = solution.rightCols(numColumns);
+    return result;
+}
+
+// Solve a prepared block for the voltages of its workspace, reusing its buffers
+void Circuit::solveBlockInPlace(int blockIndex) {
+    SolverWorkspace& workspace = workspaces[blockIndex];
+    if (!realBlocks[blockIndex]) {
+        blockSolvers[blockIndex]->solve(workspace.voltageVector, workspace.solution);
+        return;
+    }
+
+    // Only AC sources on resistors need the imaginary column
+    const RealMeshSolver& solver = *realBlockSolvers[blockIndex];
+    bool hasImaginary = !workspace.voltageVector.imag().isZero(0.0);
+    workspace.realRhs.resize(workspace.voltageVector.size(), hasImaginary ? 2 : 1);
+    workspace.realRhs.col(0) = workspace.voltageVector.real();
+    if (hasImaginary) {
+        workspace.realRhs.col(1) = workspace.voltageVector.imag();
+    }
+    solver.solve(workspace.realRhs, workspace.realSolution);
+
+    workspace.solution.resize(workspace.voltageVector.size());
+    workspace.solution.real() = workspace.realSolution.col(0);
+    if (hasImaginary) {
+        workspace.solution.imag() = workspace.realSolution.col(1);
+    } else {
+        workspace.solution.imag().setZero();
+    }
+}
+
+// Scatter the solution of a block workspace back to circuit order
+void Circuit::scatterBlockSolution(int blockIndex, std::vector<std::complex<double>>& currents) const {
+    const Eigen::VectorXcd& solution = workspaces[blockIndex].solution;
+    const std::vector<int>& blockMeshes = partition.getBlock(blockIndex).meshes;
+    for (size_t local = 0; local < blockMeshes.size(); ++local) {
+        currents[blockMeshes[local]] = solution(local);
+    }
+}
+
+// Run a task for every block, in parallel when there is enough work to split.
+// The serial path calls the task directly, without wrapping it in a std::function.
+template <typename Task>
+void Circuit::forEachBlock(Task&& task) const {
+    int numBlocks = partition.getNumBlocks();
+    int totalSize = compiled.getNumMeshes() + compiled.getNumCurrentSources();
+    if (parallelSolve && numBlocks > 1 && totalSize >= PARALLEL_SOLVE_THRESHOLD) {
+        ThreadPool::shared().parallelFor(numBlocks, task);
+    } else {
+        for (int blockIndex = 0; blockIndex < numBlocks; blockIndex++) {
+            task(blockIndex);
+        }
+    }
+}
+
+// Solve every block of a compiled circuit into currents, one mesh current per entry
+void Circuit::solveCompiledInto(const CompiledCircuit& values, std::vector<std::complex<double>>& currents) {
+    currents.assign(values.getNumMeshes(), 0.0);
+
+    forEachBlock([&](int blockIndex) {
+        // Ill-conditioned small blocks fall through to the solver policy and its QR fallback
+        if (usesFixedSizeSolver(values, blockIndex) && solveSmallBlock(values, blockIndex, currents)) {
+            return;
+        }
+
+        // Solve the system of equations in the block workspace
+        prepareBlock(values, blockIndex);
+        solveBlockInPlace(blockIndex);
+        scatterBlockSolution(blockIndex, currents);
+    });
+}
+
+// Use linear algebra to calculate mesh currents, one independent block at a time
+void Circuit::solveMeshCurrents() {
+    refreshTopology();
+    compiled.gatherValues();
+    solveCompiledInto(compiled, meshCurrents);
+}
+
+// Compile the circuit: a flat image of its topology and current values
+CompiledCircuit Circuit::compile() {
+    refreshTopology();
+    compiled.gatherValues();
+    return compiled;
+}
+
+// Solve a variant compiled from this circuit and return its mesh currents
+std::vector<std::complex<double>> Circuit::solveCompiled(const CompiledCircuit& variant) {
+    refreshTopology();
+    if (!variant.sharesTopology(compiled)) {
+        throw std::runtime_error("Compiled circuit does not match the current topology!");
+    }
+    std::vector<std::complex<double>> currents;
+    solveCompiledInto(variant, currents);
+    return currents;
+}
+
+// Solve a variant with caller-owned solvers and scratch. Every solver keeps the
+// analysis of its block, so a caller solving many variants of one topology pays
+// for the symbolic phase once. Blocks without a source carry no current.
+void Circuit::solveVariant(const CompiledCircuit& variant, std::vector<MeshSolver>& solvers, 
+                           SolverWorkspace& workspace, std::vector<std::complex<double>>& currents) const {
+    if (!variant.sharesTopology(compiled)) {
+        throw std::runtime_error("Compiled circuit does not match the current topology!");
+    }
+    if (solvers.size() != static_cast<size_t>(partition.getNumBlocks())) {
+        throw std::runtime_error("Variant solves need one solver per block!");
+    }
+    currents.assign(variant.getNumMeshes(), 0.0);
+
+    for (int blockIndex = 0; blockIndex < partition.getNumBlocks(); blockIndex++) {
+        assembleBlockAs<std::complex<double>>(variant, blockIndex, workspace.complexTriplets, workspace.voltageVector);
+        if (workspace.voltageVector.isZero(0.0)) {
+            continue;
+        }
+        MeshSolver& solver = solvers[blockIndex];
+        solver.prepare(workspace.complexTriplets, workspace.voltageVector.size(), solverMode);
+        solver.solve(workspace.voltageVector, workspace.solution);
+
+        const std::vector<int>& blockMeshes = partition.getBlock(blockIndex).meshes;
+        for (size_t local = 0; local < blockMeshes.size(); ++local) {
+            currents[blockMeshes[local]] = workspace.solution(local);
+        }
+    }
+}
+
+// Assemble a block after a single load changed and hand the change to its solver.
+// A load in meshes a and b changes the block matrix by delta * u * u^T with
+// u = e_a - e_b (u = e_a for a single mesh).
+template <typename Scalar>
+void Circuit::updateBlockAs(BasicMeshSolver<Scalar>& solver, int blockIndex, int loadIndex, Scalar delta, 
+                            std::vector<Eigen::Triplet<Scalar>>& triplets, Eigen::VectorXcd& voltageVector) {
+    assembleBlockAs<Scalar>(compiled, blockIndex, triplets, voltageVector);
+    int size = voltageVector.size();
+
+    const int* loadMeshes = compiled.loadMeshesBegin(loadIndex);
+    int meshCount = compiled.loadMeshesEnd(loadIndex) - loadMeshes;
+    // Opening or closing a load changes the size of the system instead of a matrix entry
+    bool opensOrCloses = size != solver.getSize() || !std::isfinite(std::abs(delta));
+    if (opensOrCloses || meshCount > 2 || (meshCount == 2 && loadMeshes[0] == loadMeshes[1])) {
+        solver.prepare(triplets, size, solverMode);
+        return;
+    }
+
+    typename BasicMeshSolver<Scalar>::Vector direction = BasicMeshSolver<Scalar>::Vector::Zero(size);
+    direction(partition.getLocalIndex(loadMeshes[0])) = Scalar(1);
+    if (meshCount == 2) {
+        direction(partition.getLocalIndex(loadMeshes[1])) = Scalar(-1);
+    }
+    solver.update(triplets, size, solverMode, direction, delta);
+}
+
+// Change the impedance of one load and re-solve its block through a low-rank
+// update of the cached factorization instead of a full refactor
+void Circuit::updateLoadImpedance(Load* load, std::complex<double> impedance) {
+    refreshTopology();
+    int loadIndex = compiled.getIncidence().findLoad(load);
+    if (loadIndex < 0) {
+        throw std::runtime_error("Load is not part of the circuit!");
+    }
+
+    std::complex<double> delta = impedance - load->getImpedance();
+    load->setImpedance(impedance);
+    compiled.gatherValues();
+    int blockIndex = partition.getMeshBlock(*compiled.loadMeshesBegin(loadIndex));
+
+    // Small blocks are cheaper to solve again than to update
+    if (usesFixedSizeSolver(compiled, blockIndex) && meshCurrents.size() == meshes.size()) {
+        if (!solveSmallBlock(compiled, blockIndex, meshCurrents)) {
+            prepareBlock(compiled, blockIndex);
+            solveBlockInPlace(blockIndex);
+            scatterBlockSolution(blockIndex, meshCurrents);
+        }
+        return;
+    }
+
+    SolverWorkspace& workspace = workspaces[blockIndex];
+    realBlocks[blockIndex] = isResistiveBlock(compiled, blockIndex);
+    if (realBlocks[blockIndex]) {
+        updateBlockAs<double>(*realBlockSolvers[blockIndex], blockIndex, loadIndex, delta.real(), 
+                              workspace.realTriplets, workspace.voltageVector);
+    } else {
+        updateBlockAs<std::complex<double>>(*blockSolvers[blockIndex], blockIndex, loadIndex, delta, 
+                                            workspace.complexTriplets, workspace.voltageVector);
+    }
+
+    // Patch the currents of the affected block only
+    if (meshCurrents.size() != meshes.size()) {
+        solveMeshCurrents();
+        return;
+    }
+    solveBlockInPlace(blockIndex);
+    scatterBlockSolution(blockIndex, meshCurrents);
+}
+
+// Solve one scenario per column of mesh voltages against a single factorization.
+// Current sources keep their own values in every scenario.
+Eigen::MatrixXcd Circuit::solveMeshCurrentsBatch(const Eigen::MatrixXcd& meshVoltages) {
+    int numMeshes = meshes.size();
+    if (meshVoltages.rows() != numMeshes) {
+        throw std::runtime_error("Batch voltages must have one row per mesh!");
+    }
+    refreshTopology();
+    compiled.gatherValues();
+    Eigen::MatrixXcd result(numMeshes, meshVoltages.cols());
+
+    forEachBlock([&](int blockIndex) {
+        prepareBlock(compiled, blockIndex);
+        const Eigen::VectorXcd& voltageVector = workspaces[blockIndex].voltageVector;
+
+        // Stack the scenarios of the block meshes over the current source constraints
+        const std::vector<int>& blockMeshes = partition.getBlock(blockIndex).meshes;
+        int numBlockMeshes = blockMeshes.size();
+        int numConstraints = voltageVector.size() - numBlockMeshes;
+        Eigen::MatrixXcd rhs(voltageVector.size(), meshVoltages.cols());
+        for (int local = 0; local < numBlockMeshes; local++) {
+            rhs.row(local) = meshVoltages.row(blockMeshes[local]);
+        }
+        rhs.bottomRows(numConstraints) = voltageVector.tail(numConstraints).replicate(1, meshVoltages.cols());
+
+        // All columns share one factorization
+        Eigen::MatrixXcd solution = solveBlock(blockIndex, rhs);
+        for (int local = 0; local < numBlockMeshes; local++) {
+            result.row(blockMeshes[local]) = solution.row(local);
+        }
+    });
+    return result;
+}
+
+// Adjoint sensitivities of y = w^T x, where A x = b is the system of a block and
+// w only weighs its mesh currents:
+// dy/dZ_k = -lambda^T (dA/dZ_k) x with A^T lambda = w. The mesh matrix is
+// complex symmetric, so the adjoint system is solved with the factorization
+// already cached for the block. dA/dZ_k has the pattern the load adds in assembly.
+std::vector<std::complex<double>> Circuit::computeSensitivities(int blockIndex, const Eigen::VectorXcd& weights) {
+    compiled.gatherValues();
+    // Refactors only if a value changed since the last solve
+    prepareBlock(compiled, blockIndex);
+    solveBlockInPlace(blockIndex);
+    const Eigen::VectorXcd& solution = workspaces[blockIndex].solution;
+    Eigen::VectorXcd paddedWeights = Eigen::VectorXcd::Zero(solution.size());
+    paddedWeights.head(weights.size()) = weights;
+    Eigen::VectorXcd adjoint = solveBlock(blockIndex, paddedWeights);
+
+    // Open loads carry no current whatever their impedance
+    std::vector<std::complex<double>> sensitivities(compiled.getNumLoads(), 0.0);
+    for (int loadIndex : partition.getBlock(blockIndex).loads) {
+        if (compiled.isOpen(loadIndex)) {
+            continue;
+        }
+        std::complex<double> sum(0.0, 0.0);
+        const int* first = compiled.loadMeshesBegin(loadIndex);
+        const int* last = compiled.loadMeshesEnd(loadIndex);
+        for (const int* row = first; row != last; ++row) {
+            int localRow = partition.getLocalIndex(*row);
+            sum += adjoint(localRow) * solution(localRow);
+            for (const int* column = row + 1; column != last; ++column) {
+                if (*row != *column) {
+                    int localColumn = partition.getLocalIndex(*column);
+                    sum -= adjoint(localRow) * solution(localColumn) + adjoint(localColumn) * solution(localRow);
+                }
+            }
+        }
+        sensitivities[loadIndex] = -sum;
+    }
+    return sensitivities;
+}
+
+// Sensitivities of one mesh current to every load impedance
+std::vector<std::complex<double>> Circuit::getMeshCurrentSensitivities(int meshIndex) {
+    refreshTopology();
+    if (meshIndex < 0 || meshIndex >= compiled.getNumMeshes()) {
+        throw std::runtime_error("Mesh index out of range!");
+    }
+    int blockIndex = partition.getMeshBlock(meshIndex);
+    Eigen::VectorXcd weights = Eigen::VectorXcd::Zero(partition.getBlock(blockIndex).meshes.size());
+    weights(partition.getLocalIndex(meshIndex)) = 1.0;
+    return computeSensitivities(blockIndex, weights);
+}
+
+// Sensitivities of one load current to every load impedance. The current is
+// oriented like the branches of Simulator: the current of the last mesh of the
+// load minus that of its first mesh when the two differ.
+std::vector<std::complex<double>> Circuit::getLoadCurrentSensitivities(Load* load) {
+    refreshTopology();
+    int loadIndex = compiled.getIncidence().findLoad(load);
+    if (loadIndex < 0) {
+        throw std::runtime_error("Load is not part of the circuit!");
+    }
+    const int* loadMeshes = compiled.loadMeshesBegin(loadIndex);
+    int meshCount = compiled.loadMeshesEnd(loadIndex) - loadMeshes;
+    if (meshCount > 2) {
+        throw std::runtime_error("Load current is only defined for loads in at most two meshes!");
+    }
+
+    int blockIndex = partition.getMeshBlock(loadMeshes[0]);
+    Eigen::VectorXcd weights = Eigen::VectorXcd::Zero(partition.getBlock(blockIndex).meshes.size());
+    weights(partition.getLocalIndex(loadMeshes[meshCount - 1])) = 1.0;
+    if (meshCount == 2 && loadMeshes[0] != loadMeshes[1]) {
+        weights(partition.getLocalIndex(loadMeshes[0])) = -1.0;
+    }
+    return computeSensitivities(blockIndex, weights);
 }
@@ -0,0 +1,79 @@
+#include "circuit/CircuitBuilder.hpp"
+
+// Constructor
+CircuitBuilder::CircuitBuilder(std::size_t initialBytes) 
+    : arena(initialBytes), loads(&arena), sources(&arena), meshes(&arena),
+      loadTable(create<LoadTable>(&arena)), circuit(create<Circuit>()) {}
+
+// Destructor
+CircuitBuilder::~CircuitBuilder() {
+    destroyAll();
+}
+
+// Run the destructors of every object; the memory itself goes with the arena
+void CircuitBuilder::destroyAll() {
+    circuit->~Circuit();
+    for (Mesh* mesh : meshes) {
+        mesh->~Mesh();
+    }
+    for (Source* source : sources) {
+        source->~Source();
+    }
+    for (Load* load : loads) {
+        load->~Load();
+    }
+    loadTable->~LoadTable();
+}
+
+// Create a mesh in the arena and append it to the circuit
+Mesh* CircuitBuilder::addMesh() {
+    Mesh* mesh = create<Mesh>(&arena);
+    meshes.push_back(mesh);
+    circuit->addMesh(mesh);
+    return mesh;
+}
+
+Mesh* CircuitBuilder::addMesh(Span<Source* const> meshSources, Span<Load* const> meshLoads) {
+    Mesh* mesh = create<Mesh>(meshSources, meshLoads, &arena);
+    meshes.push_back(mesh);
+    circuit->addMesh(mesh);
+    return mesh;
+}
+
+// Same from vectors, so temporaries and braced lists still work
+Mesh* CircuitBuilder::addMesh(std::vector<Source*> meshSources, std::vector<Load*> meshLoads) {
+    return addMesh(Span<Source* const>(meshSources), Span<Load* const>(meshLoads));
+}
+
+// Getters
+Circuit* CircuitBuilder::getCircuit() const {
+    return circuit;
+}
+
+LoadTable* CircuitBuilder::getLoadTable() const {
+    return loadTable;
+}
+
+std::size_t CircuitBuilder::getNumLoads() const {
+    return loads.size();
+}
+
+std::size_t CircuitBuilder::getNumSources() const {
+    return sources.size();
+}
+
+std::size_t CircuitBuilder::getNumMeshes() const {
+    return meshes.size();
+}
+
+// Destroy every object and release the arena, leaving an empty circuit
+void CircuitBuilder::reset() {
+    destroyAll();
+    // The lists live in the arena too, so drop their buffers before releasing it
+    std::pmr::vector<Load*>(&arena).swap(loads);
+    std::pmr::vector<Source*>(&arena).swap(sources);
+    std::pmr::vector<Mesh*>(&arena).swap(meshes);
+    arena.release();
+    loadTable = create<LoadTable>(&arena);
+    circuit = create<Circuit>();
+}
@@ -0,0 +1,86 @@
+#include "circuit/CircuitHash.hpp"
+#include <cstring>
+#include <unordered_map>
+
+// Spread the bits of a value (splitmix64 finalizer) and fold it into the hash
+static std::uint64_t combine(std::uint64_t hash, std::uint64_t value) {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return (hash ^ value) * 0x100000001b3ULL;
+}
+
+// Bits of a double, with -0.0 folded into 0.0
+static std::uint64_t bitsOf(double value) {
+    value += 0.0;
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Seeds of the two hashes; the check hash also perturbs every value before mixing
+static constexpr std::uint64_t HASH_SEED = 0xcbf29ce484222325ULL;
+static constexpr std::uint64_t CHECK_SEED = 0x84222325cbf29ce4ULL;
+static constexpr std::uint64_t CHECK_PERTURBATION = 0x5851f42d4c957f2dULL;
+
+// Fold a value into both hashes of a key
+static void add(CircuitHash::Key& key, std::uint64_t value) {
+    key.hash = combine(key.hash, value);
+    key.check = combine(key.check, value ^ CHECK_PERTURBATION);
+}
+
+static void add(CircuitHash::Key& key, std::complex<double> value) {
+    add(key, bitsOf(value.real()));
+    add(key, bitsOf(value.imag()));
+}
+
+// Keys match only if both hashes and both sizes do
+bool CircuitHash::Key::operator==(const Key& other) const {
+    return hash == other.hash && check == other.check 
+        && numMeshes == other.numMeshes && numLoads == other.numLoads;
+}
+
+bool CircuitHash::Key::operator!=(const Key& other) const {
+    return !(*this == other);
+}
+
+// Canonical hash of topology, impedances and source phasors
+CircuitHash::Key CircuitHash::compute(Circuit& circuit) {
+    const LoadIncidence& incidence = circuit.getLoadIncidence();
+    auto meshes = circuit.getMeshesView();
+    Key key{HASH_SEED, CHECK_SEED, static_cast<std::uint32_t>(meshes.size()), 
+            static_cast<std::uint32_t>(incidence.getNumLoads())};
+    add(key, static_cast<std::uint64_t>(meshes.size()));
+
+    // Which loads each mesh holds
+    for (Mesh* mesh : meshes) {
+        auto loads = mesh->getLoadsView();
+        add(key, static_cast<std::uint64_t>(loads.size()));
+        for (Load* load : loads) {
+            add(key, static_cast<std::uint64_t>(incidence.findLoad(load)));
+        }
+    }
+    // Impedances in load order
+    for (int loadIndex = 0; loadIndex < incidence.getNumLoads(); ++loadIndex) {
+        add(key, incidence.getLoad(loadIndex)->getImpedance());
+    }
+
+    // Sources of each mesh. Voltage sources only add to their mesh voltage;
+    // a current source shared by two meshes must hash differently from two
+    // equal ones, so current sources are numbered by first appearance.
+    std::unordered_map<Source*, std::uint64_t> currentSources;
+    for (Mesh* mesh : meshes) {
+        auto sources = mesh->getSourcesView();
+        add(key, static_cast<std::uint64_t>(sources.size()));
+        for (Source* source : sources) {
+            add(key, static_cast<std::uint64_t>(source->getKind()));
+            add(key, source->getValue());
+            if (source->isCurrentSource()) {
+                auto entry = currentSources.emplace(source, currentSources.size()).first;
+                add(key, entry->second);
+            }
+        }
+    }
+    return key;
+}
@@ -0,0 +1,391 @@
+#include "circuit/CircuitSnapshot.hpp"
+#include "load/components/Resistor.hpp"
+#include "load/components/Inductor.hpp"
+#include "load/components/Capacitor.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Written in native byte order; readers with the other order see it swapped
+static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+static constexpr char MAGIC[4] = {'C', 'S', 'N', 'P'};
+
+// Sections start on 8-byte boundaries
+static std::size_t alignSection(std::size_t bytes) {
+    return (bytes + 7) / 8 * 8;
+}
+
+// Whether a CSR pair is well formed: offsets start at zero, never decrease and
+// end at the number of indices, and every index is below bound
+static bool isValidCsr(Span<const std::int32_t> offsets, Span<const std::int32_t> indices, std::uint32_t bound) {
+    if (offsets[0] != 0 || static_cast<std::size_t>(offsets[offsets.size() - 1]) != indices.size()) {
+        return false;
+    }
+    for (std::size_t index = 1; index < offsets.size(); ++index) {
+        if (offsets[index] < offsets[index - 1]) {
+            return false;
+        }
+    }
+    for (std::int32_t value : indices) {
+        if (static_cast<std::uint32_t>(value) >= bound) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Byte offset of every array, derived from the counts in the header
+CircuitSnapshot::Layout CircuitSnapshot::computeLayout(const Header& header) {
+    Layout layout;
+    std::size_t cursor = alignSection(sizeof(Header));
+    auto place = [&cursor](std::size_t bytes) {
+        std::size_t offset = cursor;
+        cursor += alignSection(bytes);
+        return offset;
+    };
+    std::size_t numMeshes = header.numMeshes;
+    std::size_t numLoads = header.numLoads;
+    std::size_t numSources = header.numSources;
+
+    layout.loadImpedances = place(numLoads * sizeof(std::complex<double>));
+    layout.componentValues = place(numLoads * sizeof(double));
+    layout.angularFrequencies = place(numLoads * sizeof(double));
+    layout.tolerances = place(numLoads * sizeof(double));
+    layout.sourceValues = place(numSources * sizeof(std::complex<double>));
+    layout.sourceFrequencies = place(numSources * sizeof(double));
+    layout.loadKinds = place(numLoads * sizeof(LoadKind));
+    layout.sourceKinds = place(numSources * sizeof(SourceKind));
+    layout.meshLoadOffsets = place((numMeshes + 1) * sizeof(std::int32_t));
+    layout.meshLoadIndices = place(header.numMeshLoads * sizeof(std::int32_t));
+    layout.meshSourceOffsets = place((numMeshes + 1) * sizeof(std::int32_t));
+    layout.meshSourceIndices = place(header.numMeshSources * sizeof(std::int32_t));
+    layout.loadMeshOffsets = place((numLoads + 1) * sizeof(std::int32_t));
+    layout.loadMeshIndices = place(header.numIncidences * sizeof(std::int32_t));
+    layout.fileSize = cursor;
+    return layout;
+}
+
+// Map a snapshot file and check its header
+CircuitSnapshot::CircuitSnapshot(const std::string& path) 
+    : mapping(nullptr), mappingSize(0), header(nullptr), layout() {
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        throw std::runtime_error("Cannot open snapshot " + path + "!");
+    }
+    struct stat status;
+    if (::fstat(file, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(Header)) {
+        ::close(file);
+        throw std::runtime_error("Snapshot " + path + " is truncated!");
+    }
+    mappingSize = status.st_size;
+    mapping = ::mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw std::runtime_error("Cannot map snapshot " + path + "!");
+    }
+
+    header = static_cast<const Header*>(mapping);
+    std::string error;
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        error = "Not a circuit snapshot: " + path + "!";
+    } else if (header->byteOrder != BYTE_ORDER_MARK) {
+        error = "Snapshot " + path + " was written with another byte order!";
+    } else if (header->version != VERSION) {
+        error = "Unsupported snapshot version " + std::to_string(header->version) + "!";
+    } else {
+        layout = computeLayout(*header);
+        if (header->fileSize != mappingSize || layout.fileSize != mappingSize) {
+            error = "Snapshot " + path + " is truncated!";
+        } else if (!isValidCsr(getMeshLoadOffsets(), getMeshLoadIndices(), header->numLoads)
+                   || !isValidCsr(getMeshSourceOffsets(), getMeshSourceIndices(), header->numSources)
+                   || !isValidCsr(getLoadMeshOffsets(), getLoadMeshIndices(), header->numMeshes)) {
+            error = "Snapshot " + path + " has corrupt offsets or indices!";
+        }
+    }
+    if (!error.empty()) {
+        ::munmap(mapping, mappingSize);
+        throw std::runtime_error(error);
+    }
+}
+
+// Destructor
+CircuitSnapshot::~CircuitSnapshot() {
+    if (mapping != nullptr) {
+        ::munmap(mapping, mappingSize);
+    }
+}
+
+// View of one array of the mapping
+template <typename T>
+Span<const T> CircuitSnapshot::section(std::size_t offset, std::size_t count) const {
+    return Span<const T>(reinterpret_cast<const T*>(static_cast<const char*>(mapping) + offset), count);
+}
+
+// Write a circuit to a snapshot file
+void CircuitSnapshot::save(Circuit& circuit, const std::string& path) {
+    const LoadIncidence& incidence = circuit.getLoadIncidence();
+    auto meshes = circuit.getMeshesView();
+    int numLoads = incidence.getNumLoads();
+
+    // Loads, numbered like the incidence
+    std::vector<std::complex<double>> loadImpedances(numLoads);
+    std::vector<double> componentValues(numLoads, 0.0);
+    std::vector<double> angularFrequencies(numLoads, 0.0);
+    std::vector<double> tolerances(numLoads, 0.0);
+    std::vector<LoadKind> loadKinds(numLoads, LoadKind::LOAD);
+    std::vector<std::int32_t> loadMeshOffsets(numLoads + 1, 0);
+    std::vector<std::int32_t> loadMeshIndices;
+    for (int loadIndex = 0; loadIndex < numLoads; ++loadIndex) {
+        Load* load = incidence.getLoad(loadIndex);
+        loadImpedances[loadIndex] = load->getImpedance();
+        if (auto* component = dynamic_cast<Component*>(load)) {
+            componentValues[loadIndex] = component->getComponentValue();
+            angularFrequencies[loadIndex] = component->getAngularFrequency();
+            tolerances[loadIndex] = component->getTolerance();
+            if (dynamic_cast<Resistor*>(load)) {
+                loadKinds[loadIndex] = LoadKind::RESISTOR;
+            } else if (dynamic_cast<Inductor*>(load)) {
+                loadKinds[loadIndex] = LoadKind::INDUCTOR;
+            } else if (dynamic_cast<Capacitor*>(load)) {
+                loadKinds[loadIndex] = LoadKind::CAPACITOR;
+            }
+        }
+        loadMeshIndices.insert(loadMeshIndices.end(), incidence.meshesBegin(loadIndex), incidence.meshesEnd(loadIndex));
+        loadMeshOffsets[loadIndex + 1] = loadMeshIndices.size();
+    }
+
+    // Sources in order of first appearance, and the contents of every mesh
+    std::unordered_map<Source*, std::int32_t> sourceIndices;
+    std::vector<std::complex<double>> sourceValues;
+    std::vector<double> sourceFrequencies;
+    std::vector<SourceKind> sourceKinds;
+    std::vector<std::int32_t> meshLoadOffsets(1, 0);
+    std::vector<std::int32_t> meshLoadIndices;
+    std::vector<std::int32_t> meshSourceOffsets(1, 0);
+    std::vector<std::int32_t> meshSourceIndices;
+    for (Mesh* mesh : meshes) {
+        for (Load* load : mesh->getLoadsView()) {
+            meshLoadIndices.push_back(incidence.findLoad(load));
+        }
+        for (Source* source : mesh->getSourcesView()) {
+            auto [entry, inserted] = sourceIndices.emplace(source, static_cast<std::int32_t>(sourceValues.size()));
+            if (inserted) {
+                sourceValues.push_back(source->getValue());
+                sourceFrequencies.push_back(source->getFrequency());
+                sourceKinds.push_back(source->getKind());
+            }
+            meshSourceIndices.push_back(entry->second);
+        }
+        meshLoadOffsets.push_back(meshLoadIndices.size());
+        meshSourceOffsets.push_back(meshSourceIndices.size());
+    }
+
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.numMeshes = meshes.size();
+    header.numLoads = numLoads;
+    header.numSources = sourceValues.size();
+    header.numMeshLoads = meshLoadIndices.size();
+    header.numMeshSources = meshSourceIndices.size();
+    header.numIncidences = loadMeshIndices.size();
+    Layout layout = computeLayout(header);
+    header.fileSize = layout.fileSize;
+
+    // Lay the sections out in memory, then write them in one go
+    std::vector<char> image(layout.fileSize, 0);
+    auto copy = [&image](std::size_t offset, const void* data, std::size_t bytes) {
+        if (bytes > 0) {
+            std::memcpy(image.data() + offset, data, bytes);
+        }
+    };
+    copy(0, &header, sizeof(header));
+    copy(layout.loadImpedances, loadImpedances.data(), loadImpedances.size() * sizeof(std::complex<double>));
+    copy(layout.componentValues, componentValues.data(), componentValues.size() * sizeof(double));
+    copy(layout.angularFrequencies, angularFrequencies.data(), angularFrequencies.size() * sizeof(double));
+    copy(layout.tolerances, tolerances.data(), tolerances.size() * sizeof(double));
+    copy(layout.sourceValues, sourceValues.data(), sourceValues.size() * sizeof(std::complex<double>));
+    copy(layout.sourceFrequencies, sourceFrequencies.data(), sourceFrequencies.size() * sizeof(double));
+    copy(layout.loadKinds, loadKinds.data(), loadKinds.size() * sizeof(LoadKind));
+    copy(layout.sourceKinds, sourceKinds.data(), sourceKinds.size() * sizeof(SourceKind));
+    copy(layout.meshLoadOffsets, meshLoadOffsets.data(), meshLoadOffsets.size() * sizeof(std::int32_t));
+    copy(layout.meshLoadIndices, meshLoadIndices.data(), meshLoadIndices.size() * sizeof(std::int32_t));
+    copy(layout.meshSourceOffsets, meshSourceOffsets.data(), meshSourceOffsets.size() * sizeof(std::int32_t));
+    copy(layout.meshSourceIndices, meshSourceIndices.data(), meshSourceIndices.size() * sizeof(std::int32_t));
+    copy(layout.loadMeshOffsets, loadMeshOffsets.data(), loadMeshOffsets.size() * sizeof(std::int32_t));
+    copy(layout.loadMeshIndices, loadMeshIndices.data(), loadMeshIndices.size() * sizeof(std::int32_t));
+
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output.write(image.data(), image.size());
+    if (!output) {
+        throw std::runtime_error("Cannot write snapshot " + path + "!");
+    }
+}
+
+// Getters
+const CircuitSnapshot::Header& CircuitSnapshot::getHeader() const {
+    return *header;
+}
+
+Span<const std::complex<double>> CircuitSnapshot::getLoadImpedances() const {
+    return section<std::complex<double>>(layout.loadImpedances, header->numLoads);
+}
+
+Span<const double> CircuitSnapshot::getComponentValues() const {
+    return section<double>(layout.componentValues, header->numLoads);
+}
+
+Span<const double> CircuitSnapshot::getAngularFrequencies() const {
+    return section<double>(layout.angularFrequencies, header->numLoads);
+}
+
+Span<const double> CircuitSnapshot::getTolerances() const {
+    return section<double>(layout.tolerances, header->numLoads);
+}
+
+Span<const std::complex<double>> CircuitSnapshot::getSourceValues() const {
+    return section<std::complex<double>>(layout.sourceValues, header->numSources);
+}
+
+Span<const double> CircuitSnapshot::getSourceFrequencies() const {
+    return section<double>(layout.sourceFrequencies, header->numSources);
+}
+
+Span<const CircuitSnapshot::LoadKind> CircuitSnapshot::getLoadKinds() const {
+    return section<LoadKind>(layout.loadKinds, header->numLoads);
+}
+
+Span<const SourceKind> CircuitSnapshot::getSourceKinds() const {
+    return section<SourceKind>(layout.sourceKinds, header->numSources);
+}
+
+Span<const std::int32_t> CircuitSnapshot::getMeshLoadOffsets() const {
+    return section<std::int32_t>(layout.meshLoadOffsets, header->numMeshes + 1);
+}
+
+Span<const std::int32_t> CircuitSnapshot::getMeshLoadIndices() const {
+    return section<std::int32_t>(layout.meshLoadIndices, header->numMeshLoads);
+}
+
+Span<const std::int32_t> CircuitSnapshot::getMeshSourceOffsets() const {
+    return section<std::int32_t>(layout.meshSourceOffsets, header->numMeshes + 1);
+}
+
+Span<const std::int32_t> CircuitSnapshot::getMeshSourceIndices() const {
+    return section<std::int32_t>(layout.meshSourceIndices, header->numMeshSources);
+}
+
+Span<const std::int32_t> CircuitSnapshot::getLoadMeshOffsets() const {
+    return section<std::int32_t>(layout.loadMeshOffsets, header->numLoads + 1);
+}
+
+Span<const std::int32_t> CircuitSnapshot::getLoadMeshIndices() const {
+    return section<std::int32_t>(layout.loadMeshIndices, header->numIncidences);
+}
+
+// Recreate the circuit inside a builder and return it
+Circuit* CircuitSnapshot::build(CircuitBuilder& builder) const {
+    auto impedances = getLoadImpedances();
+    auto values = getComponentValues();
+    auto angularFrequencies = getAngularFrequencies();
+    auto tolerances = getTolerances();
+    auto loadKinds = getLoadKinds();
+    std::vector<Load*> loads(header->numLoads);
+    for (std::size_t index = 0; index < loads.size(); ++index) {
+        switch (loadKinds[index]) {
+            case LoadKind::LOAD:
+                loads[index] = builder.addLoad<Load>();
+                loads[index]->setImpedance(impedances[index]);
+                break;
+            case LoadKind::RESISTOR:
+                loads[index] = builder.addLoad<Resistor>(values[index], angularFrequencies[index]);
+                loads[index]->setImpedance(impedances[index]);
+                break;
+            case LoadKind::INDUCTOR:
+                loads[index] = builder.addLoad<Inductor>(values[index], angularFrequencies[index]);
+                loads[index]->setImpedance(impedances[index]);
+                break;
+            case LoadKind::CAPACITOR:
+                loads[index] = builder.addLoad<Capacitor>(values[index], angularFrequencies[index]);
+                loads[index]->setImpedance(impedances[index]);
+                break;
+            default:
+                throw std::runtime_error("Unknown load kind in snapshot!");
+        }
+        if (loadKinds[index] != LoadKind::LOAD) {
+            static_cast<Component*>(loads[index])->setTolerance(tolerances[index]);
+        }
+    }
+
+    auto sourceValues = getSourceValues();
+    auto sourceFrequencies = getSourceFrequencies();
+    auto sourceKinds = getSourceKinds();
+    std::vector<Source*> sources(header->numSources);
+    for (std::size_t index = 0; index < sources.size(); ++index) {
+        std::complex<double> value = sourceValues[index];
+        switch (sourceKinds[index]) {
+            case SourceKind::AC_VOLTAGE:
+                sources[index] = builder.addSource<ACVoltageSource>(value.real(), value.imag(), sourceFrequencies[index], 
+                                                                    ACSource::ValueRepresentation::RECTANGULAR);
+                break;
+            case SourceKind::AC_CURRENT:
+                sources[index] = builder.addSource<ACCurrentSource>(value.real(), value.imag(), sourceFrequencies[index], 
+                                                                    ACSource::ValueRepresentation::RECTANGULAR);
+                break;
+            case SourceKind::DC_VOLTAGE:
+                sources[index] = builder.addSource<DCVoltageSource>(value.real());
+                break;
+            case SourceKind::DC_CURRENT:
+                sources[index] = builder.addSource<DCCurrentSource>(value.real());
+                break;
+            default:
+                throw std::runtime_error("Unknown source kind in snapshot!");
+        }
+    }
+
+    // Mesh contents; the offsets and indices were validated when the file was mapped
+    auto loadOffsets = getMeshLoadOffsets();
+    auto loadIndices = getMeshLoadIndices();
+    auto sourceOffsets = getMeshSourceOffsets();
+    auto sourceIndices = getMeshSourceIndices();
+    for (std::size_t meshIndex = 0; meshIndex < header->numMeshes; ++meshIndex) {
+        std::vector<Load*> meshLoads;
+        meshLoads.reserve(loadOffsets[meshIndex + 1] - loadOffsets[meshIndex]);
+        for (std::int32_t entry = loadOffsets[meshIndex]; entry < loadOffsets[meshIndex + 1]; ++entry) {
+            meshLoads.push_back(loads[loadIndices[entry]]);
+        }
+        std::vector<Source*> meshSources;
+        meshSources.reserve(sourceOffsets[meshIndex + 1] - sourceOffsets[meshIndex]);
+        for (std::int32_t entry = sourceOffsets[meshIndex]; entry < sourceOffsets[meshIndex + 1]; ++entry) {
+            meshSources.push_back(sources[sourceIndices[entry]]);
+        }
+        builder.addMesh(meshSources, meshLoads);
+    }
+
+    // The stored incidence must be the one the rebuilt meshes compile to
+    Circuit* circuit = builder.getCircuit();
+    const LoadIncidence& incidence = circuit->getLoadIncidence();
+    auto meshOffsets = getLoadMeshOffsets();
+    auto meshIndices = getLoadMeshIndices();
+    if (incidence.getNumLoads() != static_cast<int>(loads.size())) {
+        throw std::runtime_error("Snapshot incidence does not match its meshes!");
+    }
+    for (std::size_t index = 0; index < loads.size(); ++index) {
+        const int* first = incidence.meshesBegin(index);
+        const int* last = incidence.meshesEnd(index);
+        if (incidence.getLoad(index) != loads[index] || last - first != meshOffsets[index + 1] - meshOffsets[index]
+            || !std::equal(first, last, meshIndices.begin() + meshOffsets[index])) {
+            throw std::runtime_error("Snapshot incidence does not match its meshes!");
+        }
+    }
+    return circuit;
+}
@@ -0,0 +1,199 @@
+#include "circuit/CompiledCircuit.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+
+// Constructors
+CompiledCircuit::CompiledCircuit() 
+    : topology(std::make_shared<Topology>()) {}
+
+// Flatten the topology of a list of meshes
+CompiledCircuit::CompiledCircuit(Span<Mesh* const> meshes) {
+    auto compiled = std::make_shared<Topology>();
+    int numMeshes = meshes.size();
+    compiled->numMeshes = numMeshes;
+    compiled->incidence.build(meshes);
+
+    // Loads and voltage sources of every mesh; current sources by first appearance
+    std::unordered_map<Source*, int> sourceIndices;
+    compiled->meshLoadOffsets.push_back(0);
+    compiled->meshSourceOffsets.push_back(0);
+    for (int meshIndex = 0; meshIndex < numMeshes; meshIndex++) {
+        for (Load* load : meshes[meshIndex]->getLoadsView()) {
+            compiled->meshLoadIndices.push_back(compiled->incidence.findLoad(load));
+        }
+        for (Source* source : meshes[meshIndex]->getSourcesView()) {
+            if (source->isVoltageSource()) {
+                compiled->voltageSources.push_back(source);
+                continue;
+            }
+            if (!source->isCurrentSource()) {
+                continue;
+            }
+            auto [entry, inserted] = sourceIndices.emplace(source, static_cast<int>(compiled->currentSources.size()));
+            if (inserted) {
+                compiled->currentSources.push_back(source);
+                compiled->constraintMeshes.push_back(meshIndex);
+                compiled->constraintMeshes.push_back(-1);
+            } else if (compiled->constraintMeshes[2 * entry->second + 1] < 0) {
+                compiled->constraintMeshes[2 * entry->second + 1] = meshIndex;
+            } else {
+                throw std::runtime_error("Current source shared by more than two meshes!");
+            }
+        }
+        compiled->meshLoadOffsets.push_back(compiled->meshLoadIndices.size());
+        compiled->meshSourceOffsets.push_back(compiled->voltageSources.size());
+    }
+
+    topology = std::move(compiled);
+    impedances.assign(getNumLoads(), 0.0);
+    meshVoltages.assign(numMeshes, 0.0);
+    currentSourceValues.assign(getNumCurrentSources(), 0.0);
+    gatherValues();
+}
+
+// Read the values from the loads and sources the topology was built from
+void CompiledCircuit::gatherValues() {
+    for (int loadIndex = 0; loadIndex < getNumLoads(); loadIndex++) {
+        impedances[loadIndex] = topology->incidence.getLoad(loadIndex)->getImpedance();
+    }
+    for (int meshIndex = 0; meshIndex < topology->numMeshes; meshIndex++) {
+        std::complex<double> voltage(0.0, 0.0);
+        for (int entry = topology->meshSourceOffsets[meshIndex]; entry < topology->meshSourceOffsets[meshIndex + 1]; entry++) {
+            voltage += topology->voltageSources[entry]->getValue();
+        }
+        meshVoltages[meshIndex] = voltage;
+    }
+    for (int sourceIndex = 0; sourceIndex < getNumCurrentSources(); sourceIndex++) {
+        currentSourceValues[sourceIndex] = topology->currentSources[sourceIndex]->getValue();
+    }
+}
+
+// Read the load impedances at an angular frequency instead
+void CompiledCircuit::gatherImpedancesAt(double angularFrequency) {
+    for (int loadIndex = 0; loadIndex < getNumLoads(); loadIndex++) {
+        impedances[loadIndex] = topology->incidence.getLoad(loadIndex)->getImpedanceAt(angularFrequency);
+    }
+}
+
+// Read the instantaneous source values at a time instead
+void CompiledCircuit::gatherSourcesAt(double time) {
+    for (int meshIndex = 0; meshIndex < topology->numMeshes; meshIndex++) {
+        double voltage = 0.0;
+        for (int entry = topology->meshSourceOffsets[meshIndex]; entry < topology->meshSourceOffsets[meshIndex + 1]; entry++) {
+            voltage += topology->voltageSources[entry]->getValueAt(time);
+        }
+        meshVoltages[meshIndex] = voltage;
+    }
+    for (int sourceIndex = 0; sourceIndex < getNumCurrentSources(); sourceIndex++) {
+        currentSourceValues[sourceIndex] = topology->currentSources[sourceIndex]->getValueAt(time);
+    }
+}
+
+// Read only the sources of one frequency; the others are switched off,
+// voltage sources as shorts and current sources as opens
+void CompiledCircuit::gatherSourcesOfFrequency(double frequency) {
+    for (int meshIndex = 0; meshIndex < topology->numMeshes; meshIndex++) {
+        std::complex<double> voltage(0.0, 0.0);
+        for (int entry = topology->meshSourceOffsets[meshIndex]; entry < topology->meshSourceOffsets[meshIndex + 1]; entry++) {
+            Source* source = topology->voltageSources[entry];
+            if (source->getFrequency() == frequency) {
+                voltage += source->getValue();
+            }
+        }
+        meshVoltages[meshIndex] = voltage;
+    }
+    for (int sourceIndex = 0; sourceIndex < getNumCurrentSources(); sourceIndex++) {
+        Source* source = topology->currentSources[sourceIndex];
+        currentSourceValues[sourceIndex] = source->getFrequency() == frequency ? source->getValue() : 0.0;
+    }
+}
+
+// Distinct frequencies of the sources in increasing order, zero for DC
+std::vector<double> CompiledCircuit::getSourceFrequencies() const {
+    std::vector<double> frequencies;
+    for (Source* source : topology->voltageSources) {
+        frequencies.push_back(source->getFrequency());
+    }
+    for (Source* source : topology->currentSources) {
+        frequencies.push_back(source->getFrequency());
+    }
+    std::sort(frequencies.begin(), frequencies.end());
+    frequencies.erase(std::unique(frequencies.begin(), frequencies.end()), frequencies.end());
+    return frequencies;
+}
+
+// Getters
+int CompiledCircuit::getNumMeshes() const {
+    return topology->numMeshes;
+}
+
+int CompiledCircuit::getNumLoads() const {
+    return topology->incidence.getNumLoads();
+}
+
+int CompiledCircuit::getNumCurrentSources() const {
+    return static_cast<int>(topology->currentSources.size());
+}
+
+const LoadIncidence& CompiledCircuit::getIncidence() const {
+    return topology->incidence;
+}
+
+const int* CompiledCircuit::meshLoadsBegin(int meshIndex) const {
+    return topology->meshLoadIndices.data() + topology->meshLoadOffsets[meshIndex];
+}
+
+const int* CompiledCircuit::meshLoadsEnd(int meshIndex) const {
+    return topology->meshLoadIndices.data() + topology->meshLoadOffsets[meshIndex + 1];
+}
+
+const int* CompiledCircuit::loadMeshesBegin(int loadIndex) const {
+    return topology->incidence.meshesBegin(loadIndex);
+}
+
+const int* CompiledCircuit::loadMeshesEnd(int loadIndex) const {
+    return topology->incidence.meshesEnd(loadIndex);
+}
+
+std::complex<double> CompiledCircuit::getImpedance(int loadIndex) const {
+    return impedances[loadIndex];
+}
+
+bool CompiledCircuit::isOpen(int loadIndex) const {
+    return !std::isfinite(std::abs(impedances[loadIndex]));
+}
+
+std::complex<double> CompiledCircuit::getMeshVoltage(int meshIndex) const {
+    return meshVoltages[meshIndex];
+}
+
+std::complex<double> CompiledCircuit::getCurrentSourceValue(int sourceIndex) const {
+    return currentSourceValues[sourceIndex];
+}
+
+int CompiledCircuit::getConstraintMesh(int sourceIndex, int side) const {
+    return topology->constraintMeshes[2 * sourceIndex + side];
+}
+
+Source* CompiledCircuit::getCurrentSource(int sourceIndex) const {
+    return topology->currentSources[sourceIndex];
+}
+
+bool CompiledCircuit::sharesTopology(const CompiledCircuit& other) const {
+    return topology == other.topology;
+}
+
+// Setters for scenario variants
+void CompiledCircuit::setImpedance(int loadIndex, std::complex<double> impedance) {
+    impedances.at(loadIndex) = impedance;
+}
+
+void CompiledCircuit::setMeshVoltage(int meshIndex, std::complex<double> voltage) {
+    meshVoltages.at(meshIndex) = voltage;
+}
+
+void CompiledCircuit::setCurrentSourceValue(int sourceIndex, std::complex<double> value) {
+    currentSourceValues.at(sourceIndex) = value;
+}
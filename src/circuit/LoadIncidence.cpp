@@ -0,0 +1,64 @@
+#include "circuit/LoadIncidence.hpp"
+
+// Constructor
+LoadIncidence::LoadIncidence() : loads(), meshOffsets({0}), meshIndices(), loadIndices() {}
+
+// Rebuild the index from the meshes of a circuit
+void LoadIncidence::build(Span<Mesh* const> meshes) {
+    std::vector<int> counts;
+    loads.clear();
+    loadIndices.clear();
+
+    // Number the loads in order of first appearance and count their meshes
+    for (Mesh* mesh : meshes) {
+        for (Load* load : mesh->getLoadsView()) {
+            auto [entry, inserted] = loadIndices.emplace(load, static_cast<int>(loads.size()));
+            if (inserted) {
+                loads.push_back(load);
+                counts.push_back(0);
+            }
+            counts[entry->second]++;
+        }
+    }
+
+    // Prefix sums give the row offsets
+    meshOffsets.assign(loads.size() + 1, 0);
+    for (size_t index = 0; index < loads.size(); ++index) {
+        meshOffsets[index + 1] = meshOffsets[index] + counts[index];
+    }
+
+    // Scatter the mesh indices into their rows
+    meshIndices.resize(meshOffsets.back());
+    std::vector<int> cursor(meshOffsets.begin(), meshOffsets.end() - 1);
+    for (size_t meshIndex = 0; meshIndex < meshes.size(); ++meshIndex) {
+        for (Load* load : meshes[meshIndex]->getLoadsView()) {
+            meshIndices[cursor[loadIndices[load]]++] = static_cast<int>(meshIndex);
+        }
+    }
+}
+
+// Getters
+int LoadIncidence::getNumLoads() const {
+    return static_cast<int>(loads.size());
+}
+
+Load* LoadIncidence::getLoad(int loadIndex) const {
+    return loads[loadIndex];
+}
+
+int LoadIncidence::findLoad(Load* load) const {
+    auto entry = loadIndices.find(load);
+    return entry == loadIndices.end() ? -1 : entry->second;
+}
+
+int LoadIncidence::getMeshCount(int loadIndex) const {
+    return meshOffsets[loadIndex + 1] - meshOffsets[loadIndex];
+}
+
+const int* LoadIncidence::meshesBegin(int loadIndex) const {
+    return meshIndices.data() + meshOffsets[loadIndex];
+}
+
+const int* LoadIncidence::meshesEnd(int loadIndex) const {
+    return meshIndices.data() + meshOffsets[loadIndex + 1];
+}
@@ -2,21 +2,27 @@
 #include <algorithm>
 
 // Default constructor
-Mesh::Mesh() 
-    : sources(), loads() {}
+Mesh::Mesh(std::pmr::memory_resource* resource) 
+    : sources(resource), loads(resource), revision(0) {}
 
 // Constructor with initial sources and loads
-Mesh::Mesh(std::vector<Source*> sources, std::vector<Load*> loads) 
-    : sources(std::move(sources)), loads(std::move(loads)) {}
+Mesh::Mesh(Span<Source* const> sources, Span<Load* const> loads, std::pmr::memory_resource* resource) 
+    : sources(sources.begin(), sources.end(), resource), loads(loads.begin(), loads.end(), resource), revision(0) {}
+
+// Same from vectors, so temporaries and braced lists still work
+Mesh::Mesh(std::vector<Source*> sources, std::vector<Load*> loads, std::pmr::memory_resource* resource) 
+    : Mesh(Span<Source* const>(sources), Span<Load* const>(loads), resource) {}
 
 // Add a source to the mesh
 void Mesh::addSource(Source* source) {
     sources.push_back(source);
+    revision++;
 }
 
 // Add a load to the mesh
 void Mesh::addLoad(Load* load) {
     loads.push_back(load);
+    revision++;
 }
 
 // Calculate total voltage of the mesh
@@ -24,8 +30,8 @@ std::complex<double> Mesh::calculateMeshVoltage() const {
     std::complex<double> totalVoltage(0.0, 0.0);
     
     for (const auto& source : sources) {
-        if (auto voltageSource = dynamic_cast<ACVoltageSource*>(source)) {
-            totalVoltage += voltageSource->getValue();
+        if (source->isVoltageSource()) {
+            totalVoltage += source->getValue();
         }
     }
     return totalVoltage;
@@ -42,14 +48,28 @@ std::complex<double> Mesh::calculateMeshImpedance() const {
 
 // Return a vector with all mesh loads
 std::vector<Load*> Mesh::getLoads() const {
-    return loads;
+    return std::vector<Load*>(loads.begin(), loads.end());
 }
 
 // Return a vector with all mesh sources
 std::vector<Source*> Mesh::getSources() const {
+    return std::vector<Source*>(sources.begin(), sources.end());
+}
+
+// Views of the mesh loads and sources, without copying
+Span<Load* const> Mesh::getLoadsView() const {
+    return loads;
+}
+
+Span<Source* const> Mesh::getSourcesView() const {
     return sources;
 }
 
+// Return the topology revision of the mesh
+std::size_t Mesh::getRevision() const {
+    return revision;
+}
+
 // Return a vector with all common loads between two meshes
 std::vector<Load*> Mesh::commonLoads(const Mesh* otherMesh) const {
     std::vector<Load*> common;
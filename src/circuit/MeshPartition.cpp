@@ -0,0 +1,86 @@
+#include "circuit/MeshPartition.hpp"
+#include <algorithm>
+#include <numeric>
+
+// Find the root of a mesh with path halving
+static int findRoot(std::vector<int>& parents, int mesh) {
+    while (parents[mesh] != mesh) {
+        parents[mesh] = parents[parents[mesh]];
+        mesh = parents[mesh];
+    }
+    return mesh;
+}
+
+// Merge the components of two meshes
+static void unite(std::vector<int>& parents, int first, int second) {
+    first = findRoot(parents, first);
+    second = findRoot(parents, second);
+    if (first != second) {
+        parents[std::max(first, second)] = std::min(first, second);
+    }
+}
+
+// Constructor
+MeshPartition::MeshPartition() : blocks(), meshBlocks(), localIndices() {}
+
+// Rebuild the blocks from the loads and current sources of a compiled circuit
+void MeshPartition::build(const CompiledCircuit& compiled) {
+    const LoadIncidence& incidence = compiled.getIncidence();
+    int numMeshes = compiled.getNumMeshes();
+    int numCurrentSources = compiled.getNumCurrentSources();
+    std::vector<int> parents(numMeshes);
+    std::iota(parents.begin(), parents.end(), 0);
+
+    // Shared loads and current sources couple their meshes
+    for (int loadIndex = 0; loadIndex < incidence.getNumLoads(); loadIndex++) {
+        const int* first = incidence.meshesBegin(loadIndex);
+        for (const int* mesh = first + 1; mesh < incidence.meshesEnd(loadIndex); ++mesh) {
+            unite(parents, *first, *mesh);
+        }
+    }
+    for (int sourceIndex = 0; sourceIndex < numCurrentSources; sourceIndex++) {
+        if (compiled.getConstraintMesh(sourceIndex, 1) >= 0) {
+            unite(parents, compiled.getConstraintMesh(sourceIndex, 0), compiled.getConstraintMesh(sourceIndex, 1));
+        }
+    }
+
+    // Number the blocks in order of their first mesh
+    blocks.clear();
+    meshBlocks.assign(numMeshes, -1);
+    localIndices.assign(numMeshes, -1);
+    for (int mesh = 0; mesh < numMeshes; mesh++) {
+        int root = findRoot(parents, mesh);
+        if (meshBlocks[root] < 0) {
+            meshBlocks[root] = static_cast<int>(blocks.size());
+            blocks.emplace_back();
+        }
+        meshBlocks[mesh] = meshBlocks[root];
+        localIndices[mesh] = static_cast<int>(blocks[meshBlocks[mesh]].meshes.size());
+        blocks[meshBlocks[mesh]].meshes.push_back(mesh);
+    }
+
+    // Distribute loads and current sources over the blocks
+    for (int loadIndex = 0; loadIndex < incidence.getNumLoads(); loadIndex++) {
+        blocks[meshBlocks[*incidence.meshesBegin(loadIndex)]].loads.push_back(loadIndex);
+    }
+    for (int sourceIndex = 0; sourceIndex < numCurrentSources; sourceIndex++) {
+        blocks[meshBlocks[compiled.getConstraintMesh(sourceIndex, 0)]].currentSources.push_back(sourceIndex);
+    }
+}
+
+// Getters
+int MeshPartition::getNumBlocks() const {
+    return static_cast<int>(blocks.size());
+}
+
+const MeshPartition::Block& MeshPartition::getBlock(int blockIndex) const {
+    return blocks[blockIndex];
+}
+
+int MeshPartition::getMeshBlock(int meshIndex) const {
+    return meshBlocks[meshIndex];
+}
+
+int MeshPartition::getLocalIndex(int meshIndex) const {
+    return localIndices[meshIndex];
+}
@@ -0,0 +1,40 @@
+#ifndef FREQUENCYSWEEP_HPP
+#define FREQUENCYSWEEP_HPP
+
+#include "circuit/Circuit.hpp"
+#include <functional>
+#include <vector>
+
+// AC sweep: solves the mesh system of a circuit at every point of a frequency
+// grid, re-evaluating component impedances from their stored values. Points are
+// spread over the shared thread pool and each worker reuses the sparsity
+// analysis of its blocks across all of its points.
+class FrequencySweep {
+public:
+    // Receives the mesh currents of one point; calls are serialized but arrive out of order
+    using Callback = std::function<void(int pointIndex, double frequency, 
+                                        const std::vector<std::complex<double>>& meshCurrents)>;
+
+private:
+    // Private fields
+    Circuit* circuit;
+    std::vector<double> frequencies;
+
+public:
+    // Constructor using a grid of frequencies in hertz
+    FrequencySweep(Circuit* circuit, std::vector<double> frequencies);
+
+    // Grids of points between two frequencies, both ends included
+    static std::vector<double> linearGrid(double startFrequency, double stopFrequency, int numPoints);
+    static std::vector<double> logGrid(double startFrequency, double stopFrequency, int numPoints);
+
+    // Stream the mesh currents of every point to a callback
+    void run(const Callback& callback) const;
+    // Collect the mesh currents of every point, one column per frequency
+    Eigen::MatrixXcd run() const;
+
+    // Getters
+    const std::vector<double>& getFrequencies() const;
+};
+
+#endif // FREQUENCYSWEEP_HPP
@@ -0,0 +1,37 @@
+#ifndef HISTOGRAM_HPP
+#define HISTOGRAM_HPP
+
+#include <vector>
+
+// Fixed-range histogram with equal bins. Values outside the range are only
+// counted, so memory does not depend on how many values are added.
+class Histogram {
+private:
+    // Private fields
+    double lower;
+    double upper;
+    std::vector<long long> counts;
+    long long underflow;
+    long long overflow;
+
+public:
+    // Constructor
+    Histogram();
+    Histogram(double lower, double upper, int numBins);
+
+    // Add one value
+    void add(double value);
+    // Fold in the counts of a histogram with the same bins
+    void merge(const Histogram& other);
+
+    // Getters
+    double getLower() const;
+    double getUpper() const;
+    int getNumBins() const;
+    double getBinWidth() const;
+    const std::vector<long long>& getCounts() const;
+    long long getUnderflow() const;
+    long long getOverflow() const;
+};
+
+#endif // HISTOGRAM_HPP
@@ -0,0 +1,70 @@
+#ifndef MONTECARLOANALYSIS_HPP
+#define MONTECARLOANALYSIS_HPP
+
+#include "analysis/Histogram.hpp"
+#include "analysis/RunningStatistics.hpp"
+#include "circuit/Circuit.hpp"
+#include <cstdint>
+#include <vector>
+
+// Tolerance analysis: every component with a tolerance gets a random value
+// around its nominal one and the circuit is solved again, many times. Samples
+// are split into chunks with their own random stream, so the drawn values do
+// not depend on the number of threads. Workers keep a copy of the compiled
+// circuit and their solvers across samples, and fold the current and active
+// power of every load into streaming statistics: memory does not grow with
+// the number of samples.
+class MonteCarloAnalysis {
+public:
+    // Public types
+    enum class Distribution {
+        // Uniform in [-tolerance, tolerance]
+        UNIFORM,
+        // Normal with the tolerance at three standard deviations, truncated
+        // there, so a value never leaves the tolerance band or changes sign
+        GAUSSIAN
+    };
+    // Statistics of one load over all samples
+    struct LoadStatistics {
+        RunningStatistics current;
+        RunningStatistics power;
+        Histogram currentHistogram;
+        Histogram powerHistogram;
+    };
+
+private:
+    // Private fields
+    Circuit* circuit;
+    long long numSamples;
+    std::uint64_t seed;
+    Distribution distribution;
+    int numBins;
+    double histogramSpan;
+    int numThreads;
+    std::vector<LoadStatistics> statistics;
+
+public:
+    // Constructor
+    MonteCarloAnalysis(Circuit* circuit, long long numSamples, std::uint64_t seed = 0);
+
+    // Draw every sample and accumulate the statistics of every load
+    void run();
+
+    // Getters
+    long long getNumSamples() const;
+    int getNumThreads() const;
+    Distribution getDistribution() const;
+    // Statistics of every load, in the order of the circuit's load incidence
+    const std::vector<LoadStatistics>& getStatistics() const;
+    const LoadStatistics& getStatistics(Load* load) const;
+
+    // Setters
+    void setDistribution(Distribution distribution);
+    // Histograms cover the nominal value plus or minus relativeSpan times its magnitude
+    void setHistogram(int numBins, double relativeSpan);
+    // Number of workers the chunks are spread over; zero, the default, uses one
+    // per thread of the shared pool. The drawn values do not depend on it.
+    void setNumThreads(int numThreads);
+};
+
+#endif // MONTECARLOANALYSIS_HPP
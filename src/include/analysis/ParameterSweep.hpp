@@ -0,0 +1,63 @@
+#ifndef PARAMETERSWEEP_HPP
+#define PARAMETERSWEEP_HPP
+
+#include "circuit/Circuit.hpp"
+#include "load/components/Component.hpp"
+#include <vector>
+
+// Sweep of component values: each parameter is a component and a grid of
+// values for it, and the points are either every combination of the grids
+// or the grids taken side by side. Points are spread over the shared thread
+// pool; every worker solves its points on its own copy of the compiled
+// circuit, which shares the topology, without touching the components.
+// Results are columnar: one column per parameter and one per mesh current,
+// with one row per point.
+class ParameterSweep {
+public:
+    // Public types
+    enum class Combination {
+        // Every combination of the grids; the last parameter varies fastest
+        CARTESIAN,
+        // The i-th point takes the i-th value of every grid, all of the same length
+        ZIP
+    };
+
+private:
+    // Private types
+    struct Parameter {
+        Component* component;
+        std::vector<double> values;
+    };
+
+    // Private fields
+    Circuit* circuit;
+    Combination combination;
+    std::vector<Parameter> parameters;
+    Eigen::MatrixXd parameterValues;
+    Eigen::MatrixXcd meshCurrents;
+
+public:
+    // Constructor
+    explicit ParameterSweep(Circuit* circuit, Combination combination = Combination::CARTESIAN);
+
+    // Sweep the value of a component over a list of values
+    void addParameter(Component* component, std::vector<double> values);
+    // Sweep it over evenly or logarithmically spaced values, both ends included
+    void addLinearParameter(Component* component, double startValue, double stopValue, int numPoints);
+    void addLogParameter(Component* component, double startValue, double stopValue, int numPoints);
+
+    // Number of points for the current parameters and combination
+    int getNumPoints() const;
+    // Solve every point
+    void run();
+
+    // Getters
+    Combination getCombination() const;
+    int getNumParameters() const;
+    // Parameter values of every point, one column per parameter
+    const Eigen::MatrixXd& getParameterValues() const;
+    // Mesh currents of every point, one column per mesh
+    const Eigen::MatrixXcd& getMeshCurrents() const;
+};
+
+#endif // PARAMETERSWEEP_HPP
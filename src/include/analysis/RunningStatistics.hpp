@@ -0,0 +1,34 @@
+#ifndef RUNNINGSTATISTICS_HPP
+#define RUNNINGSTATISTICS_HPP
+
+// Streaming mean and variance of a sequence (Welford's algorithm), in constant
+// memory. Accumulators filled on different threads combine with merge.
+class RunningStatistics {
+private:
+    // Private fields
+    long long count;
+    double mean;
+    double squaredDeviations;
+    double minimum;
+    double maximum;
+
+public:
+    // Constructor
+    RunningStatistics();
+
+    // Add one value
+    void add(double value);
+    // Fold in the values of another accumulator
+    void merge(const RunningStatistics& other);
+
+    // Getters
+    long long getCount() const;
+    double getMean() const;
+    // Sample variance, zero for fewer than two values
+    double getVariance() const;
+    double getStandardDeviation() const;
+    double getMinimum() const;
+    double getMaximum() const;
+};
+
+#endif // RUNNINGSTATISTICS_HPP
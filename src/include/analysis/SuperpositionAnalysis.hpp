@@ -0,0 +1,38 @@
+#ifndef SUPERPOSITIONANALYSIS_HPP
+#define SUPERPOSITIONANALYSIS_HPP
+
+#include "circuit/Circuit.hpp"
+#include <vector>
+
+// Multi-frequency steady state by superposition: sources are grouped by
+// frequency (DC being zero) and the circuit is solved once per group, with
+// component impedances evaluated at that frequency and every other source
+// switched off. The groups are independent and are solved in parallel on
+// the shared thread pool. Their phasors combine into time-domain currents.
+class SuperpositionAnalysis {
+private:
+    // Private fields
+    Circuit* circuit;
+    std::vector<double> frequencies;
+    // Mesh current phasors, one column per frequency
+    Eigen::MatrixXcd phasors;
+
+public:
+    // Constructor
+    explicit SuperpositionAnalysis(Circuit* circuit);
+
+    // Solve the circuit once per source frequency
+    void run();
+    // Instantaneous mesh currents, the sum of every frequency's contribution
+    std::vector<double> getMeshCurrentsAt(double time) const;
+    // Same for several times, one column per time
+    Eigen::MatrixXd getMeshCurrentsAt(const std::vector<double>& times) const;
+    // RMS value of every mesh current; distinct frequencies add in power
+    std::vector<double> getRmsCurrents() const;
+
+    // Getters
+    const std::vector<double>& getFrequencies() const;
+    const Eigen::MatrixXcd& getPhasors() const;
+};
+
+#endif // SUPERPOSITIONANALYSIS_HPP
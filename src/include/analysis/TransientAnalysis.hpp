@@ -0,0 +1,44 @@
+#ifndef TRANSIENTANALYSIS_HPP
+#define TRANSIENTANALYSIS_HPP
+
+#include "circuit/Circuit.hpp"
+#include "load/CompanionModel.hpp"
+#include <functional>
+#include <vector>
+
+// Time-domain analysis: steps a circuit of resistors, inductors and capacitors
+// through time, replacing each load with its series companion model and the
+// sources with their instantaneous values. The step is fixed, so every block
+// of the mesh system is factored once and each step only updates the history
+// terms of the right-hand side and solves against the cached factorization.
+// The circuit starts at rest: all currents and capacitor voltages are zero
+// at time zero, which is reported as the first point.
+class TransientAnalysis {
+public:
+    // Receives the mesh currents of one step, in order
+    using Callback = std::function<void(int stepIndex, double time, const std::vector<double>& meshCurrents)>;
+
+private:
+    // Private fields
+    Circuit* circuit;
+    double timeStep;
+    int numSteps;
+    IntegrationMethod method;
+
+public:
+    // Constructor using a step in seconds and the number of steps after time zero
+    TransientAnalysis(Circuit* circuit, double timeStep, int numSteps,
+                      IntegrationMethod method = IntegrationMethod::TRAPEZOIDAL);
+
+    // Stream the mesh currents of every step to a callback
+    void run(const Callback& callback) const;
+    // Collect the mesh currents of every step, one column per point in time
+    Eigen::MatrixXd run() const;
+
+    // Getters
+    double getTimeStep() const;
+    int getNumSteps() const;
+    IntegrationMethod getMethod() const;
+};
+
+#endif // TRANSIENTANALYSIS_HPP
@@ -2,14 +2,84 @@
 #define CIRCUIT_HPP
 
 #include "circuit/Mesh.hpp"
+#include "circuit/CompiledCircuit.hpp"
+#include "circuit/LoadIncidence.hpp"
+#include "circuit/MeshPartition.hpp"
+#include "solver/MeshSolver.hpp"
+#include "solver/SolverWorkspace.hpp"
+#include "utils/Span.hpp"
+#include <memory>
+#include <unordered_map>
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 
 class Circuit {
+public:
+    // Public types
+    using SolverMode = SolverKind;
+
 private:
     // Meshes in this circuit
     std::vector<Mesh*> meshes;  
     // Currents of the meshes
     std::vector<std::complex<double>> meshCurrents;
+    // Strategy used to solve the mesh system
+    SolverMode solverMode;
+    // Whether independent blocks are solved on the shared thread pool
+    bool parallelSolve;
+    // Compiled topology and the mesh revisions it was built from
+    CompiledCircuit compiled;
+    MeshPartition partition;
+    std::size_t topologySignature;
+    // Cached analysis and factorization of each independent block. Purely
+    // resistive blocks are solved in real arithmetic by their own solver.
+    std::vector<std::unique_ptr<MeshSolver>> blockSolvers;
+    std::vector<std::unique_ptr<RealMeshSolver>> realBlockSolvers;
+    std::vector<char> realBlocks;
+    // Scratch buffers of each block, reused by every solve
+    std::vector<SolverWorkspace> workspaces;
+
+    // Rebuild the compiled topology if any mesh changed since the last build
+    void refreshTopology();
+    // Fill the system of one block through an entry callback
+    template <typename Scalar, typename Sink>
+    void assembleBlockWith(const CompiledCircuit& values, int blockIndex, Sink&& addEntry, 
+                           std::complex<double>* voltages) const;
+    // Fill the system of one block as triplets in real or complex arithmetic
+    template <typename Scalar>
+    void assembleBlockAs(const CompiledCircuit& values, int blockIndex, 
+                         std::vector<Eigen::Triplet<Scalar>>& triplets, Eigen::VectorXcd& voltageVector) const;
+    // Assemble a block after a single load changed and hand the change to its solver
+    template <typename Scalar>
+    void updateBlockAs(BasicMeshSolver<Scalar>& solver, int blockIndex, int loadIndex, Scalar delta, 
+                       std::vector<Eigen::Triplet<Scalar>>& triplets, Eigen::VectorXcd& voltageVector);
+    // Whether every load of a block has a purely real impedance
+    bool isResistiveBlock(const CompiledCircuit& values, int blockIndex) const;
+    // Assemble a block into its workspace and bring its persistent solver up to date
+    void prepareBlock(const CompiledCircuit& values, int blockIndex);
+    // Solve a small block on the stack with the fixed-size kernels; false if it is too ill-conditioned
+    template <typename Scalar, int Columns>
+    bool solveSmallBlockAs(const CompiledCircuit& values, int blockIndex, std::vector<std::complex<double>>& currents);
+    bool solveSmallBlock(const CompiledCircuit& values, int blockIndex, std::vector<std::complex<double>>& currents);
+    // Solve every block of a compiled circuit into one mesh current per entry
+    void solveCompiledInto(const CompiledCircuit& values, std::vector<std::complex<double>>& currents);
+    // Whether a block goes through the fixed-size kernels
+    bool usesFixedSizeSolver(const CompiledCircuit& values, int blockIndex) const;
+    // Open loads of a block needing a constraint row holding their current at zero
+    std::vector<int> getOpenConstraints(const CompiledCircuit& values, int blockIndex) const;
+    // Number of unknowns of a block, one more per open load constraint
+    int getBlockSize(const CompiledCircuit& values, int blockIndex) const;
+    // Solve a prepared block, mapping real solutions back to complex at the edge
+    Eigen::MatrixXcd solveBlock(int blockIndex, const Eigen::MatrixXcd& rhs) const;
+    // Solve a prepared block for the voltages of its workspace into its solution
+    void solveBlockInPlace(int blockIndex);
+    // Scatter the solution of a block workspace back to circuit order
+    void scatterBlockSolution(int blockIndex, std::vector<std::complex<double>>& currents) const;
+    // Sensitivities of a weighted sum of the mesh currents of a block to every load impedance
+    std::vector<std::complex<double>> computeSensitivities(int blockIndex, const Eigen::VectorXcd& weights);
+    // Run a task for every block, in parallel when worthwhile
+    template <typename Task>
+    void forEachBlock(Task&& task) const;
 
 public:
     // Constructor
@@ -22,10 +92,59 @@ public:
     std::vector<Mesh*> getMeshes() const;
     // Return the currents of the meshes
     std::vector<std::complex<double>> getMeshCurrents() const;
+    // Views of the meshes and their currents, without copying. The current
+    // view is invalidated when a solve resizes the currents.
+    Span<Mesh* const> getMeshesView() const;
+    Span<const std::complex<double>> getMeshCurrentsView() const;
+    // Replace the mesh currents with a known solution, e.g. a cached one
+    void setMeshCurrents(Span<const std::complex<double>> currents);
     // Analyzes which current sources are in more than one mesh
-    std::unordered_map<ACCurrentSource*, std::vector<int>> Circuit::mapCurrentSourcesToMeshes() const;
+    std::unordered_map<Source*, std::vector<int>> mapCurrentSourcesToMeshes() const;
+    // Select the factorization of the mesh system, AUTO by default
+    void setSolverMode(SolverMode mode);
+    SolverMode getSolverMode() const;
+    // Enable or disable solving independent blocks in parallel
+    void setParallelSolve(bool enabled);
+    bool getParallelSolve() const;
+    // Return the load-to-mesh incidence, rebuilt if the topology changed
+    const LoadIncidence& getLoadIncidence();
+    // Return the independent blocks of the mesh system, rebuilt if the topology changed
+    const MeshPartition& getPartition();
+    // Fill the system of one block as triplets and the right-hand side vector from
+    // the values of a compiled circuit. Expects an up-to-date partition.
+    void assembleBlock(const CompiledCircuit& values, int blockIndex, 
+                       std::vector<Eigen::Triplet<std::complex<double>>>& triplets, 
+                       Eigen::VectorXcd& voltageVector) const;
+    // Same in real arithmetic, keeping only the resistance of every impedance
+    void assembleBlock(const CompiledCircuit& values, int blockIndex, 
+                       std::vector<Eigen::Triplet<double>>& triplets, 
+                       Eigen::VectorXcd& voltageVector) const;
+    // Return the persistent solvers of a block and which one its last solve used
+    const MeshSolver& getBlockSolver(int blockIndex) const;
+    const RealMeshSolver& getRealBlockSolver(int blockIndex) const;
+    bool isRealBlock(int blockIndex) const;
     // Solve for mesh currents using matrix method
     void solveMeshCurrents();  
+    // Flat image of the topology and current values; copies share the topology
+    CompiledCircuit compile();
+    // Solve a variant of compile() with edited values and return its mesh currents
+    std::vector<std::complex<double>> solveCompiled(const CompiledCircuit& variant);
+    // Solve a variant of compile() with caller-owned scratch and solvers, one per block
+    // of getPartition(). The cached solvers are left alone, so threads may solve
+    // variants concurrently with their own solvers. Expects an up-to-date partition.
+    void solveVariant(const CompiledCircuit& variant, std::vector<MeshSolver>& solvers, 
+                      SolverWorkspace& workspace, std::vector<std::complex<double>>& currents) const;
+    // Change the impedance of one load and re-solve its block through a low-rank
+    // update of the cached factorization instead of a full refactor
+    void updateLoadImpedance(Load* load, std::complex<double> impedance);
+    // Solve one scenario per column of mesh voltages against a single factorization
+    Eigen::MatrixXcd solveMeshCurrentsBatch(const Eigen::MatrixXcd& meshVoltages);
+    // Derivatives d(I)/d(Z_k) of a mesh current, or of a load current as Load::getCurrent
+    // reports it after a simulation (last mesh minus first mesh for a shared load),
+    // with respect to the impedance of every load, in load incidence order. One
+    // adjoint solve against the cached factorization gives all of them.
+    std::vector<std::complex<double>> getMeshCurrentSensitivities(int meshIndex);
+    std::vector<std::complex<double>> getLoadCurrentSensitivities(Load* load);
 };
 
 #endif // CIRCUIT_HPP
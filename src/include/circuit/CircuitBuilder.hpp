@@ -0,0 +1,88 @@
+#ifndef CIRCUITBUILDER_HPP
+#define CIRCUITBUILDER_HPP
+
+#include "circuit/Circuit.hpp"
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Builds a circuit whose loads, sources, meshes, the load and source lists of
+// the meshes and the circuit itself are allocated back to back from a
+// monotonic arena. The loads keep their state in a LoadTable of this builder
+// whose chunks come from the same arena. Pointers handed out stay valid until
+// the builder is reset or destroyed, which frees everything at once.
+class CircuitBuilder {
+private:
+    // Private fields
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::vector<Load*> loads;
+    std::pmr::vector<Source*> sources;
+    std::pmr::vector<Mesh*> meshes;
+    LoadTable* loadTable;
+    Circuit* circuit;
+
+    // Private functions
+    template <typename T, typename... Args>
+    T* create(Args&&... args);
+    void destroyAll();
+
+public:
+    // Constructors
+    explicit CircuitBuilder(std::size_t initialBytes = 4096);
+    CircuitBuilder(const CircuitBuilder&) = delete;
+    CircuitBuilder& operator=(const CircuitBuilder&) = delete;
+
+    // Destructors
+    ~CircuitBuilder();
+
+    // Create a load or source of type T in the arena
+    template <typename T, typename... Args>
+    T* addLoad(Args&&... args);
+    template <typename T, typename... Args>
+    T* addSource(Args&&... args);
+    // Create a mesh in the arena and append it to the circuit
+    Mesh* addMesh();
+    Mesh* addMesh(Span<Source* const> meshSources, Span<Load* const> meshLoads);
+    Mesh* addMesh(std::vector<Source*> meshSources, std::vector<Load*> meshLoads);
+
+    // Getters
+    Circuit* getCircuit() const;
+    LoadTable* getLoadTable() const;
+    std::size_t getNumLoads() const;
+    std::size_t getNumSources() const;
+    std::size_t getNumMeshes() const;
+
+    // Destroy every object and release the arena, leaving an empty circuit
+    void reset();
+};
+
+// Construct an object of type T in the arena
+template <typename T, typename... Args>
+T* CircuitBuilder::create(Args&&... args) {
+    void* memory = arena.allocate(sizeof(T), alignof(T));
+    return new (memory) T(std::forward<Args>(args)...);
+}
+
+// Create a load of type T in the arena
+template <typename T, typename... Args>
+T* CircuitBuilder::addLoad(Args&&... args) {
+    static_assert(std::is_base_of<Load, T>::value, "T must derive from Load");
+    LoadTable::Scope scope(*loadTable);
+    T* load = create<T>(std::forward<Args>(args)...);
+    loads.push_back(load);
+    return load;
+}
+
+// Create a source of type T in the arena
+template <typename T, typename... Args>
+T* CircuitBuilder::addSource(Args&&... args) {
+    static_assert(std::is_base_of<Source, T>::value, "T must derive from Source");
+    T* source = create<T>(std::forward<Args>(args)...);
+    sources.push_back(source);
+    return source;
+}
+
+#endif // CIRCUITBUILDER_HPP
@@ -0,0 +1,29 @@
+#ifndef CIRCUITHASH_HPP
+#define CIRCUITHASH_HPP
+
+#include "circuit/Circuit.hpp"
+#include <cstdint>
+
+// Canonical hash key of what determines a circuit's solution: the mesh
+// topology, every load impedance and every source phasor. Loads are numbered
+// by first appearance and current sources by identity, so two circuits built
+// the same way hash equal no matter where their objects live in memory.
+class CircuitHash {
+public:
+    // Two independently seeded hashes of the same description, plus the sizes
+    // of the circuit, so a collision of the first hash alone is never taken
+    // for a match
+    struct Key {
+        std::uint64_t hash;
+        std::uint64_t check;
+        std::uint32_t numMeshes;
+        std::uint32_t numLoads;
+
+        bool operator==(const Key& other) const;
+        bool operator!=(const Key& other) const;
+    };
+
+    static Key compute(Circuit& circuit);
+};
+
+#endif // CIRCUITHASH_HPP
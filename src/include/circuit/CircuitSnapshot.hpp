@@ -0,0 +1,113 @@
+#ifndef CIRCUITSNAPSHOT_HPP
+#define CIRCUITSNAPSHOT_HPP
+
+#include "circuit/Circuit.hpp"
+#include "circuit/CircuitBuilder.hpp"
+#include "utils/Span.hpp"
+#include <complex>
+#include <cstdint>
+#include <string>
+
+// Versioned binary image of a circuit. After a fixed header come flat,
+// 8-byte aligned arrays: load impedances, component values, angular
+// frequencies and tolerances, source phasors and frequencies, the kind of every load and
+// source, the loads and sources of every mesh in CSR form, and the
+// load-to-mesh incidence in the same CSR layout as LoadIncidence. Loads and
+// sources are numbered in order of first appearance. Opening a snapshot maps
+// the file read-only and validates every offset and index, so the getters are
+// checked views into the mapping.
+class CircuitSnapshot {
+public:
+    // Public types
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint32_t numMeshes;
+        std::uint32_t numLoads;
+        std::uint32_t numSources;
+        std::uint32_t numMeshLoads;
+        std::uint32_t numMeshSources;
+        std::uint32_t numIncidences;
+        std::uint32_t reserved;
+        std::uint64_t fileSize;
+    };
+
+    // Kind of a stored load; sources store their SourceKind
+    enum class LoadKind : std::uint32_t {
+        LOAD,
+        RESISTOR,
+        INDUCTOR,
+        CAPACITOR
+    };
+
+    // Format version written by save and accepted by the constructor
+    static constexpr std::uint32_t VERSION = 2;
+
+private:
+    // Byte offset of every array, derived from the counts in the header
+    struct Layout {
+        std::size_t loadImpedances;
+        std::size_t componentValues;
+        std::size_t angularFrequencies;
+        std::size_t tolerances;
+        std::size_t sourceValues;
+        std::size_t sourceFrequencies;
+        std::size_t loadKinds;
+        std::size_t sourceKinds;
+        std::size_t meshLoadOffsets;
+        std::size_t meshLoadIndices;
+        std::size_t meshSourceOffsets;
+        std::size_t meshSourceIndices;
+        std::size_t loadMeshOffsets;
+        std::size_t loadMeshIndices;
+        std::size_t fileSize;
+    };
+
+    // Private fields
+    void* mapping;
+    std::size_t mappingSize;
+    const Header* header;
+    Layout layout;
+
+    // Private functions
+    static Layout computeLayout(const Header& header);
+    template <typename T>
+    Span<const T> section(std::size_t offset, std::size_t count) const;
+
+public:
+    // Constructors
+    explicit CircuitSnapshot(const std::string& path);
+    CircuitSnapshot(const CircuitSnapshot&) = delete;
+    CircuitSnapshot& operator=(const CircuitSnapshot&) = delete;
+
+    // Destructors
+    ~CircuitSnapshot();
+
+    // Write a circuit to a snapshot file
+    static void save(Circuit& circuit, const std::string& path);
+
+    // Getters
+    const Header& getHeader() const;
+    Span<const std::complex<double>> getLoadImpedances() const;
+    Span<const double> getComponentValues() const;
+    Span<const double> getAngularFrequencies() const;
+    Span<const double> getTolerances() const;
+    Span<const std::complex<double>> getSourceValues() const;
+    Span<const double> getSourceFrequencies() const;
+    Span<const LoadKind> getLoadKinds() const;
+    Span<const SourceKind> getSourceKinds() const;
+    Span<const std::int32_t> getMeshLoadOffsets() const;
+    Span<const std::int32_t> getMeshLoadIndices() const;
+    Span<const std::int32_t> getMeshSourceOffsets() const;
+    Span<const std::int32_t> getMeshSourceIndices() const;
+    Span<const std::int32_t> getLoadMeshOffsets() const;
+    Span<const std::int32_t> getLoadMeshIndices() const;
+
+    // Recreate the circuit inside a builder and return it. Loads keep their
+    // stored impedance, even where it differs from their component value, and
+    // the stored incidence is checked against the one the meshes compile to.
+    Circuit* build(CircuitBuilder& builder) const;
+};
+
+#endif // CIRCUITSNAPSHOT_HPP
@@ -0,0 +1,83 @@
+#ifndef COMPILEDCIRCUIT_HPP
+#define COMPILEDCIRCUIT_HPP
+
+#include "circuit/LoadIncidence.hpp"
+#include "circuit/Mesh.hpp"
+#include "utils/Span.hpp"
+#include <complex>
+#include <memory>
+#include <vector>
+
+// Flat, index-based image of a circuit for the solver hot path. The topology
+// (mesh-to-load and load-to-mesh CSR arrays, voltage sources per mesh and one
+// constraint row per current source) is immutable and shared between copies.
+// The values (load impedances, mesh voltages and current source values) are
+// owned by each copy, so cloning for a scenario variant copies only them.
+class CompiledCircuit {
+private:
+    struct Topology {
+        int numMeshes = 0;
+        // Load numbering and load-to-mesh CSR
+        LoadIncidence incidence;
+        // Mesh-to-load CSR, one entry per load occurrence
+        std::vector<int> meshLoadOffsets;
+        std::vector<int> meshLoadIndices;
+        // Voltage sources of every mesh in CSR form
+        std::vector<int> meshSourceOffsets;
+        std::vector<Source*> voltageSources;
+        // Current sources in order of first appearance, with the meshes of
+        // their constraint row: two per source, the second -1 if unused
+        std::vector<Source*> currentSources;
+        std::vector<int> constraintMeshes;
+    };
+
+    // Private fields
+    std::shared_ptr<const Topology> topology;
+    std::vector<std::complex<double>> impedances;
+    std::vector<std::complex<double>> meshVoltages;
+    std::vector<std::complex<double>> currentSourceValues;
+
+public:
+    // Constructors
+    CompiledCircuit();
+    explicit CompiledCircuit(Span<Mesh* const> meshes);
+
+    // Read the values from the loads and sources the topology was built from
+    void gatherValues();
+    // Read the load impedances at an angular frequency instead
+    void gatherImpedancesAt(double angularFrequency);
+    // Read the instantaneous source values at a time instead
+    void gatherSourcesAt(double time);
+    // Read only the sources of one frequency; the others are switched off,
+    // voltage sources as shorts and current sources as opens
+    void gatherSourcesOfFrequency(double frequency);
+    // Distinct frequencies of the sources in increasing order, zero for DC
+    std::vector<double> getSourceFrequencies() const;
+
+    // Getters
+    int getNumMeshes() const;
+    int getNumLoads() const;
+    int getNumCurrentSources() const;
+    const LoadIncidence& getIncidence() const;
+    const int* meshLoadsBegin(int meshIndex) const;
+    const int* meshLoadsEnd(int meshIndex) const;
+    const int* loadMeshesBegin(int loadIndex) const;
+    const int* loadMeshesEnd(int loadIndex) const;
+    std::complex<double> getImpedance(int loadIndex) const;
+    // Whether a load is an open circuit, like a capacitor at DC
+    bool isOpen(int loadIndex) const;
+    std::complex<double> getMeshVoltage(int meshIndex) const;
+    std::complex<double> getCurrentSourceValue(int sourceIndex) const;
+    // Meshes of the constraint row of a current source; the second is -1 if unused
+    int getConstraintMesh(int sourceIndex, int side) const;
+    Source* getCurrentSource(int sourceIndex) const;
+    // Whether two compiled circuits were built from the same topology
+    bool sharesTopology(const CompiledCircuit& other) const;
+
+    // Setters for scenario variants
+    void setImpedance(int loadIndex, std::complex<double> impedance);
+    void setMeshVoltage(int meshIndex, std::complex<double> voltage);
+    void setCurrentSourceValue(int sourceIndex, std::complex<double> value);
+};
+
+#endif // COMPILEDCIRCUIT_HPP
@@ -0,0 +1,36 @@
+#ifndef LOADINCIDENCE_HPP
+#define LOADINCIDENCE_HPP
+
+#include "circuit/Mesh.hpp"
+#include "utils/Span.hpp"
+#include <unordered_map>
+#include <vector>
+
+// Compiled load-to-mesh incidence in CSR form. Every distinct load gets an
+// index, and meshIndices[meshOffsets[i] .. meshOffsets[i + 1]) lists the
+// meshes that contain load i.
+class LoadIncidence {
+private:
+    std::vector<Load*> loads;
+    std::vector<int> meshOffsets;
+    std::vector<int> meshIndices;
+    std::unordered_map<Load*, int> loadIndices;
+
+public:
+    // Constructor
+    LoadIncidence();
+
+    // Rebuild the index from the meshes of a circuit
+    void build(Span<Mesh* const> meshes);
+
+    // Getters
+    int getNumLoads() const;
+    Load* getLoad(int loadIndex) const;
+    // Index of a load, or -1 if no mesh holds it
+    int findLoad(Load* load) const;
+    int getMeshCount(int loadIndex) const;
+    const int* meshesBegin(int loadIndex) const;
+    const int* meshesEnd(int loadIndex) const;
+};
+
+#endif // LOADINCIDENCE_HPP
@@ -4,26 +4,33 @@
 // Includes
 #include <vector>
 #include <algorithm>
+#include <memory_resource>
 #include <unordered_set>
 #include "sources/DC/DCVoltageSource.hpp"
 #include "sources/DC/DCCurrentSource.hpp"
 #include "sources/AC/ACVoltageSource.hpp"
 #include "sources/AC/ACCurrentSource.hpp"
 #include "load/Load.hpp"
+#include "utils/Span.hpp"
 
 class Mesh {
 private:
-    // Loads in this mesh
-    std::vector<Source*> sources;
-    std::vector<Load*> loads;  
+    // Sources and loads in this mesh, allocated from the resource given at construction
+    std::pmr::vector<Source*> sources;
+    std::pmr::vector<Load*> loads;
+    // Incremented on every topology change
+    std::size_t revision;
     
 public:
-    // Constructors
-    Mesh();
-    Mesh(std::vector<Source*> sources, std::vector<Load*> loads);
+    // Constructors; the lists of sources and loads are allocated from the given memory resource
+    explicit Mesh(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    Mesh(Span<Source* const> sources, Span<Load* const> loads,
+         std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    Mesh(std::vector<Source*> sources, std::vector<Load*> loads,
+         std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     // Add a source to the mesh
-    void Mesh::addSource(Source* source);
+    void addSource(Source* source);
     // Add a load to the mesh
     void addLoad(Load* load);
     // Calculate total voltage of the mesh
@@ -33,7 +40,12 @@ public:
     // Return a vector with all mesh loads
     std::vector<Load*> getLoads() const;
     // Return a vector with all mesh sources
-    std::vector<Source*> Mesh::getSources() const;
+    std::vector<Source*> getSources() const;
+    // Views of the mesh loads and sources, without copying
+    Span<Load* const> getLoadsView() const;
+    Span<Source* const> getSourcesView() const;
+    // Return the topology revision of the mesh
+    std::size_t getRevision() const;
     // Return a vector with all common loads between two meshs
     std::vector<Load*> commonLoads(const Mesh* otherMesh) const;
 };
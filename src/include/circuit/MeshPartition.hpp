@@ -0,0 +1,42 @@
+#ifndef MESHPARTITION_HPP
+#define MESHPARTITION_HPP
+
+#include "circuit/CompiledCircuit.hpp"
+#include <vector>
+
+// Splits the meshes of a circuit into connected components of the graph
+// whose edges are shared loads and current sources between two meshes.
+// Each component is an independent block of the mesh system.
+class MeshPartition {
+public:
+    // Public classes
+    struct Block {
+        // Global indices of the meshes in the block, in circuit order
+        std::vector<int> meshes;
+        // Incidence indices of the loads in the block
+        std::vector<int> loads;
+        // Indices of the current sources in the block
+        std::vector<int> currentSources;
+    };
+
+private:
+    // Private fields
+    std::vector<Block> blocks;
+    std::vector<int> meshBlocks;
+    std::vector<int> localIndices;
+
+public:
+    // Constructor
+    MeshPartition();
+
+    // Rebuild the blocks from the loads and current sources of a compiled circuit
+    void build(const CompiledCircuit& compiled);
+
+    // Getters
+    int getNumBlocks() const;
+    const Block& getBlock(int blockIndex) const;
+    int getMeshBlock(int meshIndex) const;
+    int getLocalIndex(int meshIndex) const;
+};
+
+#endif // MESHPARTITION_HPP
@@ -3,4 +3,21 @@
 
 constexpr double PI = 3.14159265358979323846;
 
+// Mesh systems at or above this size are solved with sparse LU in AUTO mode
+constexpr int SPARSE_SOLVER_THRESHOLD = 40;
+// Largest fraction of nonzero entries for which AUTO still picks sparse LU
+constexpr double SPARSE_DENSITY_LIMIT = 0.35;
+// Dense LU factorizations with a lower reciprocal condition estimate fall back to QR
+constexpr double LU_RCOND_LIMIT = 1e-12;
+// LDLT pivots smaller than this times the norm of the system fail the factorization, which falls back to LU
+constexpr double LDLT_PIVOT_LIMIT = 1e-12;
+// Blocks up to this many unknowns are solved on the stack by fixed-size kernels
+constexpr int FIXED_SIZE_SOLVER_LIMIT = 8;
+// Circuits with several blocks are solved in parallel from this many unknowns
+constexpr int PARALLEL_SOLVE_THRESHOLD = 256;
+// Rank-one impedance updates absorbed before the mesh system is refactored
+constexpr int MAX_LOW_RANK_UPDATES = 16;
+// Monte Carlo samples drawn from one random stream, whatever thread runs them
+constexpr int MONTE_CARLO_CHUNK_SIZE = 1024;
+
 #endif // CONSTANTS_HPP
@@ -0,0 +1,20 @@
+#ifndef COMPANIONMODEL_HPP
+#define COMPANIONMODEL_HPP
+
+// Rule used to discretize the inductor and capacitor equations in time
+enum class IntegrationMethod {
+    BACKWARD_EULER,
+    TRAPEZOIDAL
+};
+
+// Series companion model of a load over one time step of a transient analysis:
+//   v(n) = resistance * i(n) + currentGain * i(n - 1) + voltageGain * v(n - 1)
+// The resistance only depends on the step and the method, so with a fixed step
+// the mesh system stays constant and only the history term moves each step.
+struct CompanionModel {
+    double resistance;
+    double currentGain;
+    double voltageGain;
+};
+
+#endif // COMPANIONMODEL_HPP
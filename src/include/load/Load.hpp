@@ -2,8 +2,11 @@
 #define LOAD_HPP
 
 #include "constants/Constants.hpp"
+#include "load/CompanionModel.hpp"
+#include "load/LoadTable.hpp"
 #include <complex>
 
+// Handle to one row of a LoadTable, which holds the electrical state
 class Load {
 protected:
     // Protected classes
@@ -14,25 +17,18 @@ protected:
     };
 
     // Protected fields
-    std::complex<double> impedance; 
-    std::complex<double> voltage; 
-    std::complex<double> current;
-    std::complex<double> complexPower;
-    double activePower;
-    double reactivePower;
-    double phase;
-
-    // Protected functions
-    void calculateVoltage();
-    void calculatePowers();
+    LoadTable* table;
+    int id;
 
 public:
     // Constructors
     Load();
     Load(double firstValue, double secondValue, RepresentationMode mode = RepresentationMode::POLAR_DEGREES);
+    Load(const Load& other);
+    Load& operator=(const Load& other);
 
     // Destructors
-    virtual ~Load() = default;
+    virtual ~Load();
     
     // Getters
     std::complex<double> getImpedance() const;
@@ -42,9 +38,16 @@ public:
     double getActivePower() const;
     double getReactivePower() const;
     double getPhase() const;
+    int getId() const;
+    LoadTable* getTable() const;
+    // Impedance at an angular frequency; plain loads do not depend on it
+    virtual std::complex<double> getImpedanceAt(double angularFrequency) const;
+    // Companion model for a transient step; plain loads must be purely resistive
+    virtual CompanionModel getCompanionModel(double timeStep, IntegrationMethod method) const;
     
     // Setters
     void setCurrent(std::complex<double> current);
+    void setImpedance(std::complex<double> impedance);
 };
 
 #endif // LOAD_HPP
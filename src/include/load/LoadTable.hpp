@@ -0,0 +1,139 @@
+#ifndef LOADTABLE_HPP
+#define LOADTABLE_HPP
+
+#include <atomic>
+#include <complex>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Electrical state of every load stored as one contiguous array per
+// quantity, indexed by load id. Complex quantities are split into real and
+// imaginary arrays so bulk updates and aggregate queries stream and vectorize.
+// The complex power of a load is its active plus j times its reactive power.
+// Rows live in chunks that never move once allocated, so creating loads on
+// one thread does not disturb reads of existing loads on another. The first
+// chunks are small and double in size up to CHUNK_SIZE rows, so a table of a
+// few loads stays small, and every later chunk holds CHUNK_SIZE rows;
+// allocation and release are serialized by a mutex. The directory of chunks
+// grows by doubling; a replaced directory is kept until the table dies, so a
+// reader holding it stays valid. Ids are recycled, and a slot is zeroed when
+// handed out and when released, so it never counts in aggregates.
+class LoadTable {
+public:
+    // Makes a table the one new loads are created in on this thread while in scope
+    class Scope {
+    private:
+        LoadTable* previous;
+
+    public:
+        explicit Scope(LoadTable& table);
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope();
+    };
+
+    // Implementations of the voltage and power pass; AUTO is the widest the CPU supports
+    enum class Kernel {
+        AUTO,
+        SCALAR,
+        AVX2,
+        AVX512
+    };
+
+private:
+    // Private types
+    static constexpr int FIRST_CHUNK_BITS = 5;
+    static constexpr int CHUNK_BITS = 10;
+    static constexpr int CHUNK_SIZE = 1 << CHUNK_BITS;
+    // Chunks below CHUNK_SIZE rows: one of 2^FIRST_CHUNK_BITS rows, then doubling
+    static constexpr int SMALL_CHUNKS = CHUNK_BITS - FIRST_CHUNK_BITS + 1;
+    static constexpr int NUM_QUANTITIES = 9;
+    // Header of a chunk; its rows follow it in the same allocation, one array per quantity
+    struct alignas(64) Chunk {
+        double* impedanceReal;
+        double* impedanceImag;
+        double* voltageReal;
+        double* voltageImag;
+        double* currentReal;
+        double* currentImag;
+        double* activePower;
+        double* reactivePower;
+        double* phase;
+    };
+
+    // Private fields
+    std::pmr::memory_resource* resource;
+    std::atomic<Chunk**> directory;
+    std::size_t directoryCapacity;
+    std::vector<std::pair<Chunk**, std::size_t>> retiredDirectories;
+    std::atomic<std::size_t> rowCount;
+    std::vector<int> freeIds;
+    std::mutex mutex;
+    Kernel kernel;
+
+    // Private functions
+    Chunk& chunkOf(int id) const;
+    static int chunkIndexOf(int id);
+    static int chunkStart(int chunkIndex);
+    static int chunkCapacity(int chunkIndex);
+    static std::size_t chunkBytes(int chunkIndex);
+    static int rowOf(int id);
+    void addChunk(int chunkIndex);
+    void clearSlot(int id);
+    void calculateVoltage(int id);
+    // Voltage and powers of rows [first, last) of one chunk from their impedances and currents
+    void calculateVoltages(Chunk& chunk, int first, int last) const;
+
+public:
+    // Constructors; chunks are allocated from the given memory resource
+    explicit LoadTable(std::pmr::memory_resource* resource = std::pmr::new_delete_resource());
+    LoadTable(const LoadTable&) = delete;
+    LoadTable& operator=(const LoadTable&) = delete;
+
+    // Destructors
+    ~LoadTable();
+
+    // Reserve a zeroed slot and return its id
+    int allocate();
+    // Give a slot back for reuse
+    void release(int id);
+
+    // Getters
+    std::size_t size() const;
+    std::complex<double> getImpedance(int id) const;
+    std::complex<double> getVoltage(int id) const;
+    std::complex<double> getCurrent(int id) const;
+    std::complex<double> getComplexPower(int id) const;
+    double getActivePower(int id) const;
+    double getReactivePower(int id) const;
+    double getPhase(int id) const;
+    Kernel getKernel() const;
+
+    // Setters; both recalculate the voltage and powers of the load
+    void setImpedance(int id, std::complex<double> impedance);
+    void setCurrent(int id, std::complex<double> current);
+    // Assign currents[k] to load ids[k] for every k, then recalculate the voltages
+    // and powers of those loads, vectorized over runs of consecutive ids
+    void setCurrents(const int* ids, const std::complex<double>* currents, std::size_t count);
+    // Pick the kernel of the voltage and power pass; not while another thread updates the table
+    void setKernel(Kernel kernel);
+
+    // Aggregates over every load
+    std::complex<double> getTotalComplexPower() const;
+    double getMaxCurrent() const;
+    // Id of the load carrying the largest current, or -1 if the table is empty
+    int findMaxCurrentLoad() const;
+
+    // Whether the running CPU can execute a kernel
+    static bool isSupported(Kernel kernel);
+
+    // Table used by loads created outside any Scope
+    static LoadTable& shared();
+    // Table new loads are created in on this thread
+    static LoadTable& current();
+};
+
+#endif // LOADTABLE_HPP
@@ -7,6 +7,12 @@ class Capacitor : public Component {
 public:
     // Constructor
     Capacitor(double capacitanceValue, double angularFrequency);
+
+    // Impedance at an angular frequency
+    std::complex<double> getImpedanceAt(double angularFrequency) const override;
+    std::complex<double> getImpedanceFor(double capacitanceValue, double angularFrequency) const override;
+    // Companion model for a transient step
+    CompanionModel getCompanionModel(double timeStep, IntegrationMethod method) const override;
 };
 
 #endif // CAPACITOR_HPP
@@ -8,19 +8,26 @@ protected:
     // Protected fields
     double componentValue;
     double angularFrequency;
+    // Relative tolerance of the component value, e.g. 0.05 for 5%
+    double tolerance;
 
 public:
     // Constructors
     Component();
     Component(double componentValue, double angularFrequency);
     
+    // Impedance for another component value; plain components do not depend on it
+    virtual std::complex<double> getImpedanceFor(double componentValue, double angularFrequency) const;
+
     // Getters
     double getComponentValue() const;
     double getAngularFrequency() const;
+    double getTolerance() const;
     
     // Setters
     void setComponentValue(double componentValue);
     void setAngularFrequency(double angularFrequency);
+    void setTolerance(double tolerance);
 };
 
 #endif // COMPONENT_HPP
@@ -7,6 +7,12 @@ class Inductor : public Component {
 public:
     // Constructor
     Inductor(double inductanceValue, double angularFrequency);
+
+    // Impedance at an angular frequency
+    std::complex<double> getImpedanceAt(double angularFrequency) const override;
+    std::complex<double> getImpedanceFor(double inductanceValue, double angularFrequency) const override;
+    // Companion model for a transient step
+    CompanionModel getCompanionModel(double timeStep, IntegrationMethod method) const override;
 };
 
 #endif // INDUCTOR_HPP
@@ -7,6 +7,12 @@ class Resistor : public Component {
 public:
     // Constructor
     Resistor(double resistanceValue, double angularFrequency = 0.0);
+
+    // Impedance at an angular frequency
+    std::complex<double> getImpedanceAt(double angularFrequency) const override;
+    std::complex<double> getImpedanceFor(double resistanceValue, double angularFrequency) const override;
+    // Companion model for a transient step
+    CompanionModel getCompanionModel(double timeStep, IntegrationMethod method) const override;
 };
 
 #endif // RESISTOR_HPP
@@ -0,0 +1,59 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool of worker threads shared by the parallel solvers
+class ThreadPool {
+private:
+    // Private fields
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping;
+
+    // Private functions
+    void workerLoop();
+    void enqueue(std::function<void()> task);
+
+public:
+    // Constructors
+    explicit ThreadPool(unsigned numThreads = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Destructors
+    ~ThreadPool();
+
+    // Queue a task and return a future for its result
+    template <typename Function>
+    auto submit(Function function) -> std::future<decltype(function())>;
+    // Run body(index) for every index in [0, count). The calling thread takes part,
+    // so nested calls from inside a task cannot deadlock. Rethrows the first exception.
+    void parallelFor(int count, const std::function<void(int)>& body);
+
+    // Getters
+    unsigned getNumThreads() const;
+
+    // Process-wide pool sized to the hardware
+    static ThreadPool& shared();
+};
+
+// Queue a task and return a future for its result
+template <typename Function>
+auto ThreadPool::submit(Function function) -> std::future<decltype(function())> {
+    auto task = std::make_shared<std::packaged_task<decltype(function())()>>(std::move(function));
+    auto result = task->get_future();
+    enqueue([task]() { (*task)(); });
+    return result;
+}
+
+#endif // THREADPOOL_HPP
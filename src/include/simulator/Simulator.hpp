@@ -2,24 +2,42 @@
 #define SIMULATOR_HPP
 
 #include "circuit/Circuit.hpp"
-#include <set>
-#include <unordered_map>
+#include "simulator/SolutionCache.hpp"
+#include <vector>
 
 class Simulator {
 private:
+    // Meshes whose currents make up the branch current of a load:
+    // current = I[meshA] + sign * I[meshB]. Unshared loads use sign 0.
+    struct LoadBranch {
+        Load* load;
+        int meshA;
+        int meshB;
+        double sign;
+    };
+
     Circuit* circuit;
-    std::set<Load*> sharedLoads;
+    std::vector<LoadBranch> branches;
+    // Ids of the loads in the table of the first load, and the loads kept elsewhere
+    LoadTable* table;
+    std::vector<int> loadIds;
+    std::vector<int> tableBranches;
+    std::vector<int> otherBranches;
+    // Branch currents of every load and the batch for the table, reused across runs
+    std::vector<std::complex<double>> branchCurrents;
+    std::vector<std::complex<double>> loadCurrents;
+    // Optional cache of solutions, and the buffer its hits are copied into
+    SolutionCache* cache;
+    std::vector<std::complex<double>> cachedMeshCurrents;
 
-    // List all shared loads on the circuit
+    // Build the load-to-meshes table of the circuit
     void computeSharedLoads();
-    // Implement logic to check if a load is shared between two meshes
-    bool isSharedLoad(Load* load) const;
-    // Implement the logic to obtain the index of the other mesh that shares this load
-    int getOtherMeshIndex(Load* load, int currentMeshIndex) const;
 
 public:
     Simulator(Circuit* circuit);
     void runSimulation();
+    // Share solutions of identical circuits through a cache; nullptr disables it
+    void setSolutionCache(SolutionCache* cache);
 };
 
 #endif // SIMULATOR_HPP
@@ -0,0 +1,62 @@
+#ifndef SOLUTIONCACHE_HPP
+#define SOLUTIONCACHE_HPP
+
+#include "circuit/CircuitHash.hpp"
+#include "utils/Span.hpp"
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Least-recently-used cache of solved circuits keyed by CircuitHash. Entries
+// are indexed by the first hash of the key, and a hit also needs the check
+// hash and the mesh and load counts to match, so a collision is a miss rather
+// than another circuit's solution. Each entry keeps the mesh currents and the
+// branch current of every load, in LoadIncidence order. Entries are evicted once their estimated footprint
+// exceeds the memory cap. Safe to share between threads.
+class SolutionCache {
+private:
+    struct Entry {
+        CircuitHash::Key key;
+        std::vector<std::complex<double>> meshCurrents;
+        std::vector<std::complex<double>> loadCurrents;
+        std::size_t bytes;
+    };
+
+    // Private fields
+    std::list<Entry> entries;
+    std::unordered_map<std::uint64_t, std::list<Entry>::iterator> index;
+    std::size_t capacityBytes;
+    std::size_t usedBytes;
+    std::size_t hits;
+    std::size_t misses;
+    mutable std::mutex mutex;
+
+    // Private functions
+    void evictUntil(std::size_t limit);
+
+public:
+    // Constructor
+    explicit SolutionCache(std::size_t capacityBytes);
+
+    // Copy a cached solution out and mark it as recently used; counts a hit or a miss
+    bool lookup(const CircuitHash::Key& key, std::vector<std::complex<double>>& meshCurrents, 
+                std::vector<std::complex<double>>& loadCurrents);
+    // Store a solution, evicting the least recently used ones to stay under the cap
+    void insert(const CircuitHash::Key& key, Span<const std::complex<double>> meshCurrents, 
+                Span<const std::complex<double>> loadCurrents);
+    // Drop every entry and reset the counters
+    void clear();
+
+    // Getters
+    std::size_t getHits() const;
+    std::size_t getMisses() const;
+    std::size_t getSize() const;
+    std::size_t getUsedBytes() const;
+    std::size_t getCapacityBytes() const;
+};
+
+#endif // SOLUTIONCACHE_HPP
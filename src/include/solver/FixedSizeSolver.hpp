@@ -0,0 +1,22 @@
+#ifndef FIXEDSIZESOLVER_HPP
+#define FIXEDSIZESOLVER_HPP
+
+#include "constants/Constants.hpp"
+#include <complex>
+
+// Solves small dense systems with compile-time sized Eigen matrices, picked at
+// run time from a table indexed by the system size. Every kernel works on the
+// stack, so a solve performs no heap allocation and its loops are unrolled.
+template <typename Scalar, int Columns>
+class FixedSizeSolver {
+public:
+    // Whether a system of this size has a fixed-size kernel
+    static bool supports(int size);
+    // Solve in place: matrix is size x size and rhs is size x Columns, both
+    // column-major with leading dimension size. Uses partial-pivot LU and
+    // returns false, leaving rhs untouched, when its reciprocal condition
+    // estimate is below LU_RCOND_LIMIT so the caller can use a sturdier solver.
+    static bool solve(int size, const Scalar* matrix, Scalar* rhs);
+};
+
+#endif // FIXEDSIZESOLVER_HPP
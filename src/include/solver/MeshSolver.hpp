@@ -0,0 +1,112 @@
+#ifndef MESHSOLVER_HPP
+#define MESHSOLVER_HPP
+
+#include "solver/SymmetricLDLT.hpp"
+#include "solver/SolverPolicy.hpp"
+#include <complex>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+// Persistent solver for the mesh system. It keeps the symbolic analysis
+// (sparsity pattern and column ordering) and the numeric factorization
+// between calls, and only redoes the phases invalidated by a new system.
+// The factorization is picked by SolverPolicy unless the caller forces one.
+// Symmetric rank-one changes can be absorbed without refactoring through
+// the Woodbury identity until too many of them accumulate.
+// Instantiated for complex systems and for real (purely resistive) ones.
+// Solves reuse scratch held by the solver, so one solver is not shared between threads.
+template <typename Scalar>
+class BasicMeshSolver {
+public:
+    // Public types
+    using Triplet = Eigen::Triplet<Scalar>;
+    using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+    using Vector = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+
+private:
+    // Private types
+    using SparseMatrix = Eigen::SparseMatrix<Scalar>;
+    using SparseSolver = Eigen::SparseLU<SparseMatrix, Eigen::COLAMDOrdering<int>>;
+
+    // Private fields
+    SolverKind requestedKind;
+    SolverKind kind;
+    bool analyzed;
+    bool factorized;
+    SparseMatrix systemMatrix;
+    SparseSolver sparseSolver;
+    Eigen::PartialPivLU<Matrix> luSolver;
+    SymmetricLDLT<Scalar> ldltSolver;
+    Eigen::ColPivHouseholderQR<Matrix> qrSolver;
+    int analyzeCount;
+    int factorizeCount;
+    // Low-rank terms applied on top of the factorization: U, A^-1 U, their
+    // weights, and the LU of the capacitance matrix diag(1 / weights) + U^T A^-1 U
+    Matrix updateDirections;
+    Matrix updateSolutions;
+    Vector updateWeights;
+    Eigen::PartialPivLU<Matrix> capacitanceSolver;
+    // Scratch kept between prepares: where each triplet of the last assembly
+    // landed in the compressed matrix, the values scattered there, and the
+    // dense copy handed to the dense factorizations
+    std::vector<std::pair<int, int>> tripletCoordinates;
+    std::vector<int> tripletPositions;
+    std::vector<Scalar> scatteredValues;
+    Matrix denseMatrix;
+    // Scratch of the solves, resized in place so that a repeated solve does not allocate
+    mutable Vector columnBuffer;
+    mutable Vector supernodeBuffer;
+    mutable Vector updateProjection;
+    mutable Vector updateCoefficients;
+
+    // Private functions
+    void analyze();
+    void factorize();
+    bool hasSamePattern(const SparseMatrix& matrix) const;
+    SparseMatrix buildMatrix(const std::vector<Triplet>& triplets, int size) const;
+    bool differsByRankOne(const SparseMatrix& matrix, const Vector& direction, Scalar delta) const;
+    bool loadSystem(SparseMatrix matrix, SolverKind requested);
+    void solveFactorizedColumn(const Eigen::Ref<const Vector>& rhs, Eigen::Ref<Vector> solution) const;
+    void solveSparseLower(Vector& x) const;
+    void solveQr(const Eigen::Ref<const Vector>& rhs, Eigen::Ref<Vector> solution) const;
+    template <typename Rhs, typename Destination>
+    void solveInto(const Rhs& rhs, Destination& solution) const;
+    bool scatterValues(const std::vector<Triplet>& triplets, int size);
+    void recordPositions(const std::vector<Triplet>& triplets);
+    void clearUpdates();
+
+public:
+    // Constructor
+    BasicMeshSolver();
+
+    // Bring the cached analysis and factorization up to date with a new system
+    void prepare(const std::vector<Triplet>& triplets, int size, SolverKind requested = SolverKind::AUTO);
+    // Move to a new system that differs from the prepared one by delta * direction * direction^T,
+    // refactoring only once the accumulated rank exceeds MAX_LOW_RANK_UPDATES
+    void update(const std::vector<Triplet>& triplets, int size, SolverKind requested, 
+                const Vector& direction, Scalar delta);
+    // Solve the prepared system for a right-hand side
+    Vector solve(const Vector& rhs) const;
+    // Solve the prepared system for several right-hand sides at once
+    Matrix solve(const Matrix& rhs) const;
+    // Solve into caller-owned storage, reused when it already has the right size
+    void solve(const Vector& rhs, Vector& solution) const;
+    void solve(const Matrix& rhs, Matrix& solution) const;
+    // Drop every cached phase
+    void reset();
+
+    // Getters
+    SolverKind getKind() const;
+    bool isSparse() const;
+    bool isFactorized() const;
+    int getSize() const;
+    int getUpdateRank() const;
+    int getAnalyzeCount() const;
+    int getFactorizeCount() const;
+};
+
+using MeshSolver = BasicMeshSolver<std::complex<double>>;
+using RealMeshSolver = BasicMeshSolver<double>;
+
+#endif // MESHSOLVER_HPP
@@ -0,0 +1,51 @@
+#ifndef SOLVERPOLICY_HPP
+#define SOLVERPOLICY_HPP
+
+#include <complex>
+#include <ostream>
+#include <Eigen/Sparse>
+
+// Factorizations available for the mesh system. AUTO lets the policy decide,
+// DENSE lets it decide among the dense factorizations only.
+enum class SolverKind {
+    AUTO,
+    DENSE,
+    SPARSE,
+    DENSE_LU,
+    DENSE_LDLT,
+    DENSE_QR
+};
+
+// Structural properties of an assembled mesh system
+struct SystemTraits {
+    int size;
+    int nonZeros;
+    bool symmetric;
+    bool diagonallyDominant;
+};
+
+// Picks a factorization from the structure of the system: sparse LU for large
+// systems with few nonzeros, complex-symmetric LDLT for symmetric diagonally
+// dominant systems, partial-pivot LU otherwise. QR is kept as the fallback
+// for systems that LU reports as (nearly) singular.
+class SolverPolicy {
+private:
+    // Optional destination of the selection log
+    static std::ostream* logStream;
+
+public:
+    // Inspect a compressed real or complex system
+    template <typename Scalar>
+    static SystemTraits inspect(const Eigen::SparseMatrix<Scalar>& matrix);
+    // Resolve a requested kind into a concrete factorization
+    static SolverKind choose(const SystemTraits& traits, SolverKind requested = SolverKind::AUTO);
+    // Write one line describing a selection to the log stream, if any
+    static void log(const SystemTraits& traits, SolverKind chosen);
+    // Return the printable name of a kind
+    static const char* getName(SolverKind kind);
+
+    // Send selection logs to a stream, or disable them with nullptr
+    static void setLogStream(std::ostream* stream);
+};
+
+#endif // SOLVERPOLICY_HPP
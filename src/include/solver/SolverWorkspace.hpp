@@ -0,0 +1,24 @@
+#ifndef SOLVERWORKSPACE_HPP
+#define SOLVERWORKSPACE_HPP
+
+#include <complex>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+// Scratch buffers of one block solve, kept between solves. Every buffer is
+// cleared or resized in place, so once it has grown to the size of its block
+// a repeated solve does no allocator work. Not shared between threads.
+struct SolverWorkspace {
+    // Assembled system in real or complex arithmetic
+    std::vector<Eigen::Triplet<double>> realTriplets;
+    std::vector<Eigen::Triplet<std::complex<double>>> complexTriplets;
+    // Right-hand side and solution of the block
+    Eigen::VectorXcd voltageVector;
+    Eigen::VectorXcd solution;
+    // Real and imaginary parts side by side for real systems with complex sources
+    Eigen::MatrixXd realRhs;
+    Eigen::MatrixXd realSolution;
+};
+
+#endif // SOLVERWORKSPACE_HPP
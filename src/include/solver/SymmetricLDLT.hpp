@@ -0,0 +1,38 @@
+#ifndef SYMMETRICLDLT_HPP
+#define SYMMETRICLDLT_HPP
+
+#include <complex>
+#include <Eigen/Dense>
+
+// Dense A = L * D * L^T factorization of a symmetric matrix without pivoting.
+// For complex scalars the matrix is complex symmetric, not Hermitian: Eigen's
+// LDLT conjugates, so it does not apply to impedance matrices. Only stable
+// for diagonally dominant systems, and fails on pivots that are tiny next to
+// the norm of the matrix so that callers can fall back to a pivoted solver.
+template <typename Scalar>
+class SymmetricLDLT {
+private:
+    // Private types
+    using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+    using Vector = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+
+    // Unit lower factor below the diagonal, D on the diagonal
+    Matrix factors;
+    bool success;
+
+public:
+    // Constructor
+    SymmetricLDLT();
+
+    // Factorize a matrix; only its lower triangle is read
+    void compute(const Matrix& matrix);
+    // Solve for one or more right-hand sides
+    Matrix solve(const Matrix& rhs) const;
+    // Overwrite right-hand sides with their solutions
+    void solveInPlace(Eigen::Ref<Matrix> solution) const;
+
+    // Getters
+    bool isSuccessful() const;
+};
+
+#endif // SYMMETRICLDLT_HPP
@@ -4,8 +4,8 @@
 #include "sources/Source.hpp"
 
 class ACSource : public Source {
-protected:
-    // Protected classes
+public:
+    // Public classes
     enum class ValueRepresentation {
         RECTANGULAR,
         POLAR_DEGREES,
@@ -16,6 +16,7 @@ protected:
         ANGULAR_FREQUENCY
     };
 
+protected:
     // Protected fields
     double amplitude;
     double frequency;
@@ -25,13 +26,15 @@ protected:
 
 public:
     // Constructor
-    ACSource(double firstValue, double secondValue, double thirdValue, 
+    ACSource(SourceKind kind, double firstValue, double secondValue, double thirdValue, 
                         ValueRepresentation valueMode = ValueRepresentation::POLAR_DEGREES, 
                         FrequencyRepresentation freqMode = FrequencyRepresentation::FREQUENCY);
 
     // Functions
-    virtual double getFrequency();
+    virtual double getFrequency() const;
     virtual std::complex<double> getValue();
+    // The phasor gives the peak amplitude: amplitude * cos(angularFrequency * time + phase)
+    virtual double getValueAt(double time) const;
 };
 
 #endif // ACSOURCE_HPP
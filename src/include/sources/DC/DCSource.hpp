@@ -10,10 +10,11 @@ protected:
 
 public:
     // Constructor
-    DCSource(double value);
+    DCSource(SourceKind kind, double value);
 
     // Functions
     virtual std::complex<double> getValue();
+    virtual double getValueAt(double time) const;
 };
 
 #endif // DCSOURCE_HPP
@@ -3,11 +3,36 @@
 
 #include "constants/Constants.hpp"
 #include <complex>
+#include <cstdint>
+
+// Kind of a source, fixed at construction so callers can dispatch without RTTI
+enum class SourceKind : std::uint8_t {
+    AC_VOLTAGE,
+    AC_CURRENT,
+    DC_VOLTAGE,
+    DC_CURRENT
+};
 
 class Source {
+protected:
+    // Protected fields
+    SourceKind kind;
+
+    // Constructor
+    explicit Source(SourceKind kind);
+
 public:
     // Returns the source value
     virtual std::complex<double> getValue() = 0;
+    // Returns the instantaneous value at a time in seconds
+    virtual double getValueAt(double time) const = 0;
+    // Returns the frequency in hertz, zero for DC sources
+    virtual double getFrequency() const;
+
+    // Getters
+    SourceKind getKind() const;
+    bool isVoltageSource() const;
+    bool isCurrentSource() const;
 
     // Destructors
     virtual ~Source() = default;
@@ -0,0 +1,35 @@
+#ifndef SPAN_HPP
+#define SPAN_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Non-owning view of a contiguous sequence, valid while its owner is
+// neither destroyed nor resized. Stand-in for std::span on C++17.
+template <typename T>
+class Span {
+private:
+    T* first;
+    std::size_t count;
+
+public:
+    // Constructors
+    Span() : first(nullptr), count(0) {}
+    Span(T* first, std::size_t count) : first(first), count(count) {}
+    template <typename Container, typename = std::enable_if_t<
+                  std::is_convertible_v<decltype(std::declval<Container&>().data()), T*>>>
+    Span(Container& container) : first(container.data()), count(container.size()) {}
+
+    // Iteration
+    T* begin() const { return first; }
+    T* end() const { return first + count; }
+
+    // Getters
+    T* data() const { return first; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T& operator[](std::size_t index) const { return first[index]; }
+};
+
+#endif // SPAN_HPP
@@ -1,71 +1,105 @@
 #include "load/Load.hpp"
+#include <stdexcept>
 
-// Default constructor
-Load::Load() = default;
+// Default constructor; the row comes from the table of the current LoadTable::Scope
+Load::Load() 
+    : table(&LoadTable::current()), id(table->allocate()) {}
 
 // Constructor using value representation mode
-Load::Load(double firstValue, double secondValue, RepresentationMode mode) {
+Load::Load(double firstValue, double secondValue, RepresentationMode mode) 
+    : Load() {
     switch (mode) {
         case RepresentationMode::RECTANGULAR:
-            impedance = {firstValue, secondValue};
+            table->setImpedance(id, {firstValue, secondValue});
             break;
 
         case RepresentationMode::POLAR_DEGREES: 
-            impedance = std::polar(firstValue, secondValue * PI / 180.0);
+            table->setImpedance(id, std::polar(firstValue, secondValue * PI / 180.0));
             break;
 
         case RepresentationMode::POLAR_RADIANS:
-            impedance = std::polar(firstValue, secondValue);
+            table->setImpedance(id, std::polar(firstValue, secondValue));
             break;
     }
-    phase = std::arg(impedance);
 }
 
-// Calculate voltage and powers
-void Load::calculateVoltage() {
-    voltage = impedance * current;
-    calculatePowers();
+// Copies get a row of their own
+Load::Load(const Load& other) 
+    : Load() {
+    *this = other;
 }
 
-void Load::calculatePowers() {
-    complexPower  = voltage * std::conj(current);
-    activePower   = complexPower.real();
-    reactivePower = complexPower.imag();
+Load& Load::operator=(const Load& other) {
+    table->setImpedance(id, other.getImpedance());
+    table->setCurrent(id, other.getCurrent());
+    return *this;
+}
+
+// Destructor
+Load::~Load() {
+    table->release(id);
 }
 
 // Getters
 std::complex<double> Load::getImpedance() const {
-    return impedance;
+    return table->getImpedance(id);
 }
 
 std::complex<double> Load::getVoltage() const {
-    return voltage;
+    return table->getVoltage(id);
 }
 
 std::complex<double> Load::getCurrent() const {
-    return current;
+    return table->getCurrent(id);
 }
 
 std::complex<double> Load::getComplexPower() const {
-    return complexPower;
+    return table->getComplexPower(id);
 }
 
 double Load::getActivePower() const {
-    return activePower;
+    return table->getActivePower(id);
 }
 
 double Load::getReactivePower() const {
-    return reactivePower;
+    return table->getReactivePower(id);
 }
 
 double Load::getPhase() const {
-    return phase;
+    return table->getPhase(id);
+}
+
+int Load::getId() const {
+    return id;
+}
+
+LoadTable* Load::getTable() const {
+    return table;
+}
+
+// Impedance at an angular frequency; plain loads do not depend on it
+std::complex<double> Load::getImpedanceAt(double /*angularFrequency*/) const {
+    return getImpedance();
+}
+
+// Companion model for a transient step; a reactance has no time-domain meaning without its element
+CompanionModel Load::getCompanionModel(double /*timeStep*/, IntegrationMethod /*method*/) const {
+    if (getImpedance().imag() != 0.0) {
+        throw std::runtime_error("Load with a reactance has no transient model!");
+    }
+    return {getImpedance().real(), 0.0, 0.0};
 }
 
 // Setter for current
 void Load::setCurrent(std::complex<double> newCurrent) {
-    if (current != newCurrent) {
-        current = newCurrent;
-        calculateVoltage();
+    if (getCurrent() != newCurrent) {
+        table->setCurrent(id, newCurrent);
+    }
+}
+
+// Setter for impedance
+void Load::setImpedance(std::complex<double> newImpedance) {
+    if (getImpedance() != newImpedance) {
+        table->setImpedance(id, newImpedance);
     }
 }
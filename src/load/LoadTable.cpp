@@ -0,0 +1,412 @@
+#include "load/LoadTable.hpp"
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include <stdexcept>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LOADTABLE_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+// Table set by the innermost Scope of this thread
+static thread_local LoadTable* scopedTable = nullptr;
+
+// Constructor
+LoadTable::LoadTable(std::pmr::memory_resource* resource)
+    : resource(resource), directory(nullptr), directoryCapacity(0), rowCount(0), kernel(Kernel::AUTO) {
+
+    setKernel(Kernel::AUTO);
+}
+
+// Destructor
+LoadTable::~LoadTable() {
+    Chunk** chunks = directory.load(std::memory_order_relaxed);
+    int count = static_cast<int>(rowCount.load(std::memory_order_relaxed));
+    int numChunks = count == 0 ? 0 : chunkIndexOf(count - 1) + 1;
+    for (int chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex) {
+        resource->deallocate(chunks[chunkIndex], chunkBytes(chunkIndex), alignof(Chunk));
+    }
+    retiredDirectories.emplace_back(chunks, directoryCapacity);
+    for (const auto& [retired, capacity] : retiredDirectories) {
+        if (retired != nullptr) {
+            resource->deallocate(retired, capacity * sizeof(Chunk*), alignof(Chunk*));
+        }
+    }
+}
+
+// Index of the highest set bit of a positive value
+static int highestBit(unsigned value) {
+#ifdef __GNUC__
+    return 31 - __builtin_clz(value);
+#else
+    int bit = 0;
+    while (value >>= 1) {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+// Chunk of an id: small chunks cover the first CHUNK_SIZE ids, chunk k >= 1
+// of them starting at 2^(FIRST_CHUNK_BITS + k - 1), and full chunks the rest
+int LoadTable::chunkIndexOf(int id) {
+    if (id >= CHUNK_SIZE) {
+        return SMALL_CHUNKS + (id >> CHUNK_BITS) - 1;
+    }
+    return id < (1 << FIRST_CHUNK_BITS) ? 0 : highestBit(id) - FIRST_CHUNK_BITS + 1;
+}
+
+// First id of a chunk
+int LoadTable::chunkStart(int chunkIndex) {
+    if (chunkIndex >= SMALL_CHUNKS) {
+        return (chunkIndex - SMALL_CHUNKS + 1) << CHUNK_BITS;
+    }
+    return chunkIndex == 0 ? 0 : 1 << (FIRST_CHUNK_BITS + chunkIndex - 1);
+}
+
+// Rows of a chunk
+int LoadTable::chunkCapacity(int chunkIndex) {
+    return chunkIndex >= SMALL_CHUNKS ? CHUNK_SIZE : 1 << (FIRST_CHUNK_BITS + std::max(chunkIndex - 1, 0));
+}
+
+// Size of a chunk allocation: the header followed by every quantity array
+std::size_t LoadTable::chunkBytes(int chunkIndex) {
+    return sizeof(Chunk) + NUM_QUANTITIES * chunkCapacity(chunkIndex) * sizeof(double);
+}
+
+// Chunk and row of an id
+LoadTable::Chunk& LoadTable::chunkOf(int id) const {
+    return *directory.load(std::memory_order_acquire)[chunkIndexOf(id)];
+}
+
+int LoadTable::rowOf(int id) {
+    return id - chunkStart(chunkIndexOf(id));
+}
+
+// Reserve a zeroed slot and return its id. A new chunk is published before
+// the row count, so readers never see a row without its storage.
+int LoadTable::allocate() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!freeIds.empty()) {
+        int id = freeIds.back();
+        freeIds.pop_back();
+        return id;
+    }
+
+    int id = static_cast<int>(rowCount.load(std::memory_order_relaxed));
+    if (rowOf(id) == 0) {
+        addChunk(chunkIndexOf(id));
+    }
+    // Chunks are not zeroed up front: a row is cleared when first handed out
+    clearSlot(id);
+    rowCount.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+// Allocate a chunk, doubling the directory first if it is full. The new
+// directory is published whole; the old one stays readable until destruction.
+// Every array holds a multiple of eight rows, so each starts on a cache line.
+void LoadTable::addChunk(int chunkIndex) {
+    Chunk** chunks = directory.load(std::memory_order_relaxed);
+    if (static_cast<std::size_t>(chunkIndex) == directoryCapacity) {
+        std::size_t capacity = directoryCapacity == 0 ? 4 : 2 * directoryCapacity;
+        Chunk** grown = static_cast<Chunk**>(resource->allocate(capacity * sizeof(Chunk*), alignof(Chunk*)));
+        std::copy(chunks, chunks + chunkIndex, grown);
+        if (chunks != nullptr) {
+            retiredDirectories.emplace_back(chunks, directoryCapacity);
+        }
+        chunks = grown;
+        directoryCapacity = capacity;
+    }
+    Chunk* chunk = new (resource->allocate(chunkBytes(chunkIndex), alignof(Chunk))) Chunk;
+    double* rows = reinterpret_cast<double*>(chunk + 1);
+    int capacity = chunkCapacity(chunkIndex);
+    for (double** quantity : {&chunk->impedanceReal, &chunk->impedanceImag, &chunk->voltageReal, 
+                              &chunk->voltageImag, &chunk->currentReal, &chunk->currentImag, 
+                              &chunk->activePower, &chunk->reactivePower, &chunk->phase}) {
+        *quantity = rows;
+        rows += capacity;
+    }
+    chunks[chunkIndex] = chunk;
+    directory.store(chunks, std::memory_order_release);
+}
+
+// Give a slot back for reuse
+void LoadTable::release(int id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    clearSlot(id);
+    freeIds.push_back(id);
+}
+
+// Zero every quantity of a slot
+void LoadTable::clearSlot(int id) {
+    Chunk& chunk = chunkOf(id);
+    int row = rowOf(id);
+    chunk.impedanceReal[row] = chunk.impedanceImag[row] = 0.0;
+    chunk.voltageReal[row] = chunk.voltageImag[row] = 0.0;
+    chunk.currentReal[row] = chunk.currentImag[row] = 0.0;
+    chunk.activePower[row] = chunk.reactivePower[row] = 0.0;
+    chunk.phase[row] = 0.0;
+}
+
+// Calculate voltage and powers
+void LoadTable::calculateVoltage(int id) {
+    calculateVoltages(chunkOf(id), rowOf(id), rowOf(id) + 1);
+}
+
+// Kernels for V = Z * I and S = V * conj(I) over rows [first, last); the vector ones
+// finish the rows past the last full vector with the scalar loop
+static void calculateVoltagesScalar(const double* resistance, const double* reactance,
+                                    const double* real, const double* imag,
+                                    double* voltageReal, double* voltageImag,
+                                    double* activePower, double* reactivePower, int first, int last) {
+    for (int index = first; index < last; ++index) {
+        double vr = resistance[index] * real[index] - reactance[index] * imag[index];
+        double vi = resistance[index] * imag[index] + reactance[index] * real[index];
+        voltageReal[index] = vr;
+        voltageImag[index] = vi;
+        activePower[index] = vr * real[index] + vi * imag[index];
+        reactivePower[index] = vi * real[index] - vr * imag[index];
+    }
+}
+
+#ifdef LOADTABLE_X86_DISPATCH
+// Compiled for AVX2 regardless of the build flags; only called when the CPU has it
+__attribute__((target("avx2")))
+static void calculateVoltagesAvx2(const double* resistance, const double* reactance,
+                                  const double* real, const double* imag,
+                                  double* voltageReal, double* voltageImag,
+                                  double* activePower, double* reactivePower, int first, int last) {
+    int index = first;
+    for (; index + 4 <= last; index += 4) {
+        __m256d r = _mm256_loadu_pd(resistance + index);
+        __m256d x = _mm256_loadu_pd(reactance + index);
+        __m256d ir = _mm256_loadu_pd(real + index);
+        __m256d ii = _mm256_loadu_pd(imag + index);
+        __m256d vr = _mm256_sub_pd(_mm256_mul_pd(r, ir), _mm256_mul_pd(x, ii));
+        __m256d vi = _mm256_add_pd(_mm256_mul_pd(r, ii), _mm256_mul_pd(x, ir));
+        _mm256_storeu_pd(voltageReal + index, vr);
+        _mm256_storeu_pd(voltageImag + index, vi);
+        _mm256_storeu_pd(activePower + index, _mm256_add_pd(_mm256_mul_pd(vr, ir), _mm256_mul_pd(vi, ii)));
+        _mm256_storeu_pd(reactivePower + index, _mm256_sub_pd(_mm256_mul_pd(vi, ir), _mm256_mul_pd(vr, ii)));
+    }
+    calculateVoltagesScalar(resistance, reactance, real, imag, voltageReal, voltageImag,
+                            activePower, reactivePower, index, last);
+}
+
+// Compiled for AVX-512 regardless of the build flags; only called when the CPU has it
+__attribute__((target("avx512f")))
+static void calculateVoltagesAvx512(const double* resistance, const double* reactance,
+                                    const double* real, const double* imag,
+                                    double* voltageReal, double* voltageImag,
+                                    double* activePower, double* reactivePower, int first, int last) {
+    int index = first;
+    for (; index + 8 <= last; index += 8) {
+        __m512d r = _mm512_loadu_pd(resistance + index);
+        __m512d x = _mm512_loadu_pd(reactance + index);
+        __m512d ir = _mm512_loadu_pd(real + index);
+        __m512d ii = _mm512_loadu_pd(imag + index);
+        __m512d vr = _mm512_sub_pd(_mm512_mul_pd(r, ir), _mm512_mul_pd(x, ii));
+        __m512d vi = _mm512_add_pd(_mm512_mul_pd(r, ii), _mm512_mul_pd(x, ir));
+        _mm512_storeu_pd(voltageReal + index, vr);
+        _mm512_storeu_pd(voltageImag + index, vi);
+        _mm512_storeu_pd(activePower + index, _mm512_add_pd(_mm512_mul_pd(vr, ir), _mm512_mul_pd(vi, ii)));
+        _mm512_storeu_pd(reactivePower + index, _mm512_sub_pd(_mm512_mul_pd(vi, ir), _mm512_mul_pd(vr, ii)));
+    }
+    calculateVoltagesScalar(resistance, reactance, real, imag, voltageReal, voltageImag,
+                            activePower, reactivePower, index, last);
+}
+#endif
+
+// Whether the running CPU can execute a kernel
+bool LoadTable::isSupported(Kernel kernel) {
+#ifdef LOADTABLE_X86_DISPATCH
+    __builtin_cpu_init();
+    if (kernel == Kernel::AVX512) {
+        return __builtin_cpu_supports("avx512f");
+    }
+    if (kernel == Kernel::AVX2) {
+        return __builtin_cpu_supports("avx2");
+    }
+#else
+    if (kernel == Kernel::AVX512 || kernel == Kernel::AVX2) {
+        return false;
+    }
+#endif
+    return true;
+}
+
+void LoadTable::calculateVoltages(Chunk& chunk, int first, int last) const {
+    switch (kernel) {
+#ifdef LOADTABLE_X86_DISPATCH
+        case Kernel::AVX512:
+            calculateVoltagesAvx512(chunk.impedanceReal, chunk.impedanceImag, chunk.currentReal, chunk.currentImag,
+                                    chunk.voltageReal, chunk.voltageImag, chunk.activePower, chunk.reactivePower,
+                                    first, last);
+            break;
+        case Kernel::AVX2:
+            calculateVoltagesAvx2(chunk.impedanceReal, chunk.impedanceImag, chunk.currentReal, chunk.currentImag,
+                                  chunk.voltageReal, chunk.voltageImag, chunk.activePower, chunk.reactivePower,
+                                  first, last);
+            break;
+#endif
+        default:
+            calculateVoltagesScalar(chunk.impedanceReal, chunk.impedanceImag, chunk.currentReal, chunk.currentImag,
+                                    chunk.voltageReal, chunk.voltageImag, chunk.activePower, chunk.reactivePower,
+                                    first, last);
+            break;
+    }
+}
+
+// Getters
+std::size_t LoadTable::size() const {
+    return rowCount.load(std::memory_order_acquire);
+}
+
+std::complex<double> LoadTable::getImpedance(int id) const {
+    const Chunk& chunk = chunkOf(id);
+    return {chunk.impedanceReal[rowOf(id)], chunk.impedanceImag[rowOf(id)]};
+}
+
+std::complex<double> LoadTable::getVoltage(int id) const {
+    const Chunk& chunk = chunkOf(id);
+    return {chunk.voltageReal[rowOf(id)], chunk.voltageImag[rowOf(id)]};
+}
+
+std::complex<double> LoadTable::getCurrent(int id) const {
+    const Chunk& chunk = chunkOf(id);
+    return {chunk.currentReal[rowOf(id)], chunk.currentImag[rowOf(id)]};
+}
+
+std::complex<double> LoadTable::getComplexPower(int id) const {
+    const Chunk& chunk = chunkOf(id);
+    return {chunk.activePower[rowOf(id)], chunk.reactivePower[rowOf(id)]};
+}
+
+double LoadTable::getActivePower(int id) const {
+    return chunkOf(id).activePower[rowOf(id)];
+}
+
+double LoadTable::getReactivePower(int id) const {
+    return chunkOf(id).reactivePower[rowOf(id)];
+}
+
+double LoadTable::getPhase(int id) const {
+    return chunkOf(id).phase[rowOf(id)];
+}
+
+// The kernel in use, never AUTO
+LoadTable::Kernel LoadTable::getKernel() const {
+    return kernel;
+}
+
+// Setters
+void LoadTable::setImpedance(int id, std::complex<double> impedance) {
+    Chunk& chunk = chunkOf(id);
+    chunk.impedanceReal[rowOf(id)] = impedance.real();
+    chunk.impedanceImag[rowOf(id)] = impedance.imag();
+    chunk.phase[rowOf(id)] = std::arg(impedance);
+    calculateVoltage(id);
+}
+
+void LoadTable::setCurrent(int id, std::complex<double> current) {
+    Chunk& chunk = chunkOf(id);
+    chunk.currentReal[rowOf(id)] = current.real();
+    chunk.currentImag[rowOf(id)] = current.imag();
+    calculateVoltage(id);
+}
+
+// Assign currents[k] to load ids[k] for every k, then recalculate the voltages
+// and powers of those loads only. Runs of consecutive ids within a chunk, the
+// common case for loads created together, go through the vectorized pass; no
+// other row is touched, so circuits sharing the table can be updated concurrently.
+void LoadTable::setCurrents(const int* ids, const std::complex<double>* currents, std::size_t count) {
+    for (std::size_t index = 0; index < count; ++index) {
+        Chunk& chunk = chunkOf(ids[index]);
+        chunk.currentReal[rowOf(ids[index])] = currents[index].real();
+        chunk.currentImag[rowOf(ids[index])] = currents[index].imag();
+    }
+
+    std::size_t start = 0;
+    while (start < count) {
+        std::size_t end = start + 1;
+        while (end < count && ids[end] == ids[end - 1] + 1 && rowOf(ids[end]) != 0) {
+            end++;
+        }
+        calculateVoltages(chunkOf(ids[start]), rowOf(ids[start]), rowOf(ids[start]) + static_cast<int>(end - start));
+        start = end;
+    }
+}
+
+// Pick the kernel of the voltage and power pass, resolving AUTO to the widest supported one
+void LoadTable::setKernel(Kernel newKernel) {
+    if (newKernel == Kernel::AUTO) {
+        newKernel = isSupported(Kernel::AVX512) ? Kernel::AVX512
+                  : isSupported(Kernel::AVX2) ? Kernel::AVX2 : Kernel::SCALAR;
+    }
+    if (!isSupported(newKernel)) {
+        throw std::runtime_error("Load table kernel is not supported by this CPU!");
+    }
+    kernel = newKernel;
+}
+
+// Aggregates over every load
+std::complex<double> LoadTable::getTotalComplexPower() const {
+    double active = 0.0;
+    double reactive = 0.0;
+    int count = static_cast<int>(size());
+    for (int chunkIndex = 0, first = 0; first < count; first += chunkCapacity(chunkIndex++)) {
+        const Chunk& chunk = chunkOf(first);
+        int rows = std::min(chunkCapacity(chunkIndex), count - first);
+        for (int row = 0; row < rows; ++row) {
+            active += chunk.activePower[row];
+            reactive += chunk.reactivePower[row];
+        }
+    }
+    return {active, reactive};
+}
+
+double LoadTable::getMaxCurrent() const {
+    int id = findMaxCurrentLoad();
+    return id < 0 ? 0.0 : std::abs(getCurrent(id));
+}
+
+int LoadTable::findMaxCurrentLoad() const {
+    int worst = -1;
+    double worstSquared = -1.0;
+    int count = static_cast<int>(size());
+    for (int chunkIndex = 0, first = 0; first < count; first += chunkCapacity(chunkIndex++)) {
+        const Chunk& chunk = chunkOf(first);
+        int rows = std::min(chunkCapacity(chunkIndex), count - first);
+        for (int row = 0; row < rows; ++row) {
+            double squared = chunk.currentReal[row] * chunk.currentReal[row]
+                           + chunk.currentImag[row] * chunk.currentImag[row];
+            if (squared > worstSquared) {
+                worstSquared = squared;
+                worst = first + row;
+            }
+        }
+    }
+    return worst;
+}
+
+// Table used by loads created outside any Scope
+LoadTable& LoadTable::shared() {
+    static LoadTable table;
+    return table;
+}
+
+// Table new loads are created in on this thread
+LoadTable& LoadTable::current() {
+    return scopedTable != nullptr ? *scopedTable : shared();
+}
+
+// Scope constructor and destructor
+LoadTable::Scope::Scope(LoadTable& table)
+    : previous(scopedTable) {
+    scopedTable = &table;
+}
+
+LoadTable::Scope::~Scope() {
+    scopedTable = previous;
+}
@@ -3,6 +3,30 @@
 // Constructor
 Capacitor::Capacitor(double capacitanceValue, double angularFrequency) 
     : Component(capacitanceValue, angularFrequency) {
-        
-    impedance = std::complex<double>(0.0, -1 / (angularFrequency * componentValue));
+
+    // A capacitor is an open circuit at DC
+    if (angularFrequency == 0.0) {
+        throw std::runtime_error("Angular frequency cannot be zero!");
+    }
+    setImpedance(getImpedanceAt(angularFrequency));
+}
+
+// Impedance at an angular frequency
+std::complex<double> Capacitor::getImpedanceAt(double angularFrequency) const {
+    return getImpedanceFor(componentValue, angularFrequency);
+}
+
+std::complex<double> Capacitor::getImpedanceFor(double capacitanceValue, double angularFrequency) const {
+    return std::complex<double>(0.0, -1 / (angularFrequency * capacitanceValue));
+}
+
+// Companion model for a transient step from i = C dv/dt:
+//   backward Euler  v(n) = v(n - 1) + (h / C) * i(n)
+//   trapezoidal     v(n) = v(n - 1) + (h / 2C) * (i(n) + i(n - 1))
+CompanionModel Capacitor::getCompanionModel(double timeStep, IntegrationMethod method) const {
+    if (method == IntegrationMethod::BACKWARD_EULER) {
+        return {timeStep / componentValue, 0.0, 1.0};
+    }
+    double resistance = timeStep / (2 * componentValue);
+    return {resistance, resistance, 1.0};
 }
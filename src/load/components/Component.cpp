@@ -1,21 +1,23 @@
 #include "load/components/Component.hpp"
 
 // Default constructor
-Component::Component() = default;
+Component::Component() 
+    : componentValue(0.0), angularFrequency(0.0), tolerance(0.0) {}
 
 // Constructor using component value and angular frequency
 Component::Component(double componentValue, double angularFrequency)
-    : componentValue(componentValue), angularFrequency(angularFrequency) {
+    : componentValue(componentValue), angularFrequency(angularFrequency), tolerance(0.0) {
     
-    if (angularFrequency == 0.0) {
-        throw std::runtime_error("Angular frequency cannot be zero!");
-    }
-
     if (componentValue == 0.0) {
         throw std::runtime_error("Component value cannot be zero!");
     }
 }
 
+// Impedance for another component value; plain components do not depend on it
+std::complex<double> Component::getImpedanceFor(double /*componentValue*/, double angularFrequency) const {
+    return getImpedanceAt(angularFrequency);
+}
+
 // Getters
 double Component::getComponentValue() const {
     return componentValue;
@@ -25,11 +27,28 @@ double Component::getAngularFrequency() const {
     return angularFrequency;
 }
 
+double Component::getTolerance() const {
+    return tolerance;
+}
+
 // Setters
+// Both setters keep the stored impedance in step with the new value
 void Component::setComponentValue(double newComponentValue) {
+    if (newComponentValue == 0.0) {
+        throw std::runtime_error("Component value cannot be zero!");
+    }
     componentValue = newComponentValue;
+    setImpedance(getImpedanceAt(angularFrequency));
 }
 
 void Component::setAngularFrequency(double newAngularFrequency) {
     angularFrequency = newAngularFrequency;
+    setImpedance(getImpedanceAt(angularFrequency));
+}
+
+void Component::setTolerance(double newTolerance) {
+    if (newTolerance < 0.0 || newTolerance >= 1.0) {
+        throw std::runtime_error("Component tolerance must be in [0, 1)!");
+    }
+    tolerance = newTolerance;
 }
@@ -3,5 +3,26 @@
 // Constructor
 Inductor::Inductor(double inductanceValue, double angularFrequency) 
     : Component(inductanceValue, angularFrequency) {
-    this->impedance = std::complex<double>(0.0, this->angularFrequency * this->componentValue);
+    setImpedance(getImpedanceAt(this->angularFrequency));
+}
+
+// Impedance at an angular frequency
+std::complex<double> Inductor::getImpedanceAt(double angularFrequency) const {
+    return getImpedanceFor(this->componentValue, angularFrequency);
+}
+
+std::complex<double> Inductor::getImpedanceFor(double inductanceValue, double angularFrequency) const {
+    return std::complex<double>(0.0, angularFrequency * inductanceValue);
+}
+
+// Companion model for a transient step from v = L di/dt:
+//   backward Euler  v(n) = (L / h) * (i(n) - i(n - 1))
+//   trapezoidal     v(n) = (2L / h) * (i(n) - i(n - 1)) - v(n - 1)
+CompanionModel Inductor::getCompanionModel(double timeStep, IntegrationMethod method) const {
+    if (method == IntegrationMethod::BACKWARD_EULER) {
+        double resistance = this->componentValue / timeStep;
+        return {resistance, -resistance, 0.0};
+    }
+    double resistance = 2 * this->componentValue / timeStep;
+    return {resistance, -resistance, -1.0};
 }
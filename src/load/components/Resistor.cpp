@@ -3,5 +3,19 @@
 // Constructor
 Resistor::Resistor(double resistanceValue, double angularFrequency) 
     : Component(resistanceValue, angularFrequency) {
-        this->impedance = std::complex<double>(this->componentValue, 0.0);
+        setImpedance(getImpedanceAt(this->angularFrequency));
+}
+
+// Impedance at an angular frequency
+std::complex<double> Resistor::getImpedanceAt(double angularFrequency) const {
+    return getImpedanceFor(this->componentValue, angularFrequency);
+}
+
+std::complex<double> Resistor::getImpedanceFor(double resistanceValue, double /*angularFrequency*/) const {
+    return std::complex<double>(resistanceValue, 0.0);
+}
+
+// Companion model for a transient step: v = R * i
+CompanionModel Resistor::getCompanionModel(double /*timeStep*/, IntegrationMethod /*method*/) const {
+    return {this->componentValue, 0.0, 0.0};
 }
@@ -11,6 +11,7 @@
 // Circuits includes
 #include "circuit/Mesh.hpp"
 #include "circuit/Circuit.hpp"
+#include "circuit/CircuitBuilder.hpp"
 #include "simulator/Simulator.hpp"
 // General C++ includes
 #include <iostream>
@@ -18,23 +19,25 @@
 #include <complex>
 
 int main() {
+    // The builder owns every component and releases them all at the end
+    CircuitBuilder builder;
+
     // Creating voltage sources
-    ACVoltageSource* voltageSource1  = new ACVoltageSource(60.0, 20.0 , 60.0); // 50V, 20°, 60Hz
-    ACVoltageSource* voltageSource2  = new ACVoltageSource(-10.0, 70.0, 60.0); // -10V, 70°, 60Hz
+    ACVoltageSource* voltageSource1  = builder.addSource<ACVoltageSource>(60.0, 20.0 , 60.0); // 50V, 20°, 60Hz
+    ACVoltageSource* voltageSource2  = builder.addSource<ACVoltageSource>(-10.0, 70.0, 60.0); // -10V, 70°, 60Hz
 
     // Creating loads
-    Load* load1 = new Load(30.0, 30.0); // 30/_30° ohms
-    Load* load2 = new Load(40.0, 60.0); // 40/_60° ohms
-    Load* load3 = new Load(15.0, 20.0); // 15/_50° ohms
+    Load* load1 = builder.addLoad<Load>(30.0, 30.0); // 30/_30° ohms
+    Load* load2 = builder.addLoad<Load>(40.0, 60.0); // 40/_60° ohms
+    Load* load3 = builder.addLoad<Load>(15.0, 20.0); // 15/_50° ohms
 
     // Creating the first mesh with the loads
     std::vector<Source*> sources1   = {voltageSource1};
     std::vector<Load*> loads1       = {load1};
-    Mesh* mesh1                     = new Mesh(sources1, loads1);
+    builder.addMesh(sources1, loads1);
 
-    // Creating a circuit with the mesh
-    std::vector<Mesh*> meshes   = {mesh1};
-    Circuit* circuit            = new Circuit(meshes);
+    // The circuit holds every mesh added to the builder
+    Circuit* circuit            = builder.getCircuit();
 
     // Simulating the circuit
     Simulator simulator(circuit);
@@ -44,15 +47,10 @@ int main() {
     std::cout << "Mesh 1 Current : "           << std::abs(circuit->getMeshCurrents()[0])  << "/_" << (180.0 / std::acos(-1)) * std::arg(circuit->getMeshCurrents()[0])    << " A" << std::endl;
     //std::cout << "Mesh 2 Current : "           << std::abs(circuit->getMeshCurrents()[1])  << "/_" << (180.0 / std::acos(-1)) * std::arg(circuit->getMeshCurrents()[1])    << " A" << std::endl;
 
-    // Clean memory
-    delete voltageSource1;
-    delete voltageSource2;
-    delete load1;
-    delete load2;
-    delete load3;
-    delete mesh1;
-    //delete mesh2;
-    delete circuit;
+    // Unused components are released with the builder as well
+    (void)voltageSource2;
+    (void)load2;
+    (void)load3;
 
     return 0;
 }
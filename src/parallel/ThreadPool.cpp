@@ -0,0 +1,122 @@
+#include "parallel/ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+// Constructor
+ThreadPool::ThreadPool(unsigned numThreads) : stopping(false) {
+    numThreads = std::max(1u, numThreads);
+    workers.reserve(numThreads);
+    for (unsigned index = 0; index < numThreads; ++index) {
+        workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+// Destructor: finish queued tasks and join the workers
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// Wait for tasks and run them until the pool stops
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+// Push a task on the queue and wake one worker
+void ThreadPool::enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push(std::move(task));
+    }
+    condition.notify_one();
+}
+
+// Run body(index) for every index in [0, count)
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& body) {
+    if (count <= 0) {
+        return;
+    }
+    int numChunks = std::min<int>(count, static_cast<int>(workers.size()) * 4);
+    if (numChunks == 1) {
+        for (int index = 0; index < count; ++index) {
+            body(index);
+        }
+        return;
+    }
+
+    // Shared with the helpers, which may start after this call has returned
+    struct State {
+        std::atomic<int> nextChunk{0};
+        std::atomic<int> doneChunks{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+
+    // Claim chunks until none are left; late helpers return immediately
+    auto runChunks = [state, count, numChunks, &body]() {
+        int chunk;
+        while ((chunk = state->nextChunk.fetch_add(1)) < numChunks) {
+            int begin = static_cast<int>(static_cast<long long>(count) * chunk / numChunks);
+            int end = static_cast<int>(static_cast<long long>(count) * (chunk + 1) / numChunks);
+            try {
+                for (int index = begin; index < end; ++index) {
+                    body(index);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->error) {
+                    state->error = std::current_exception();
+                }
+            }
+            if (state->doneChunks.fetch_add(1) + 1 == numChunks) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    int numHelpers = std::min<int>(numChunks, static_cast<int>(workers.size())) - 1;
+    for (int helper = 0; helper < numHelpers; ++helper) {
+        enqueue(runChunks);
+    }
+    runChunks();
+
+    // Wait for the chunks still running on helpers
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&state, numChunks]() { return state->doneChunks.load() == numChunks; });
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+// Getters
+unsigned ThreadPool::getNumThreads() const {
+    return static_cast<unsigned>(workers.size());
+}
+
+// Process-wide pool sized to the hardware
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
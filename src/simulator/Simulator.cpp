@@ -1,57 +1,89 @@
 #include "simulator/Simulator.hpp"
+#include "circuit/CircuitHash.hpp"
+#include <stdexcept>
 
-Simulator::Simulator(Circuit* circuit) : circuit(circuit) {
+Simulator::Simulator(Circuit* circuit) : circuit(circuit), table(nullptr), cache(nullptr) {
     // Precompute shared loads
     computeSharedLoads();
 }
 
-// List all shared loads on the circuit
+// Build the load-to-meshes table of the circuit. A shared load carries the
+// current of its last mesh minus the current of the other one.
 void Simulator::computeSharedLoads() {
-    std::unordered_map<Load*, int> loadCount;
-    for (Mesh* mesh : circuit->getMeshes()) {
-        for (Load* load : mesh->getLoads()) {
-            loadCount[load]++;
-            if (loadCount[load] == 2) {
-                sharedLoads.insert(load);
-            }
+    const LoadIncidence& incidence = circuit->getLoadIncidence();
+    int numLoads = incidence.getNumLoads();
+    branches.clear();
+    branches.reserve(numLoads);
+
+    for (int loadIndex = 0; loadIndex < numLoads; ++loadIndex) {
+        const int* first = incidence.meshesBegin(loadIndex);
+        int count = incidence.getMeshCount(loadIndex);
+        if (count > 2) {
+            throw std::runtime_error("Load shared by more than two meshes!");
+        }
+        LoadBranch branch{incidence.getLoad(loadIndex), first[count - 1], first[0], 0.0};
+        if (count == 2 && first[0] != first[1]) {
+            branch.sign = -1.0;
         }
+        branches.push_back(branch);
     }
-}
 
-// Calculate the mesh currents
-void Simulator::runSimulation() {
-    circuit->solveMeshCurrents();
-    const auto& meshCurrents = circuit->getMeshCurrents();
-    const auto& meshes = circuit->getMeshes();
-
-    for (size_t index = 0; index < meshes.size(); ++index) {
-        Mesh* mesh = meshes[index];
-        std::complex<double> meshCurrent = meshCurrents[index];
-
-        for (Load* load : mesh->getLoads()) {
-            if (sharedLoads.find(load) == sharedLoads.end()) {
-                load->setCurrent(meshCurrent);
-            } else {
-                int otherMeshIndex = getOtherMeshIndex(load, index);
-                std::complex<double> otherMeshCurrent = meshCurrents[otherMeshIndex];
-                load->setCurrent(meshCurrent - otherMeshCurrent);
-            }
+    // Split the loads by table so the common case is one batch update
+    table = branches.empty() ? nullptr : branches.front().load->getTable();
+    loadIds.clear();
+    tableBranches.clear();
+    otherBranches.clear();
+    for (int index = 0; index < numLoads; ++index) {
+        Load* load = branches[index].load;
+        if (load->getTable() == table) {
+            loadIds.push_back(load->getId());
+            tableBranches.push_back(index);
+        } else {
+            otherBranches.push_back(index);
         }
     }
+    branchCurrents.resize(numLoads);
+    loadCurrents.resize(tableBranches.size());
 }
 
-// Implement logic to check if a load is shared between two meshes
-bool Simulator::isSharedLoad(Load* load) const {
-    return sharedLoads.find(load) != sharedLoads.end();
-}
+// Calculate the mesh currents, then the voltages and powers of every load in one batch.
+// With a cache, a circuit identical to one solved before skips the solve entirely.
+void Simulator::runSimulation() {
+    CircuitHash::Key key{};
+    bool cached = false;
+    if (cache != nullptr) {
+        key = CircuitHash::compute(*circuit);
+        cached = cache->lookup(key, cachedMeshCurrents, branchCurrents);
+    }
 
-// Implement the logic to obtain the index of the other mesh that shares this load
-int Simulator::getOtherMeshIndex(Load* load, int currentMeshIndex) const {
-    const auto& meshes = circuit->getMeshes();
-    for (size_t index = 0; index < meshes.size(); ++index) {
-        if (index != currentMeshIndex && isSharedLoad(load)) {
-            return static_cast<int>(index);
+    if (cached) {
+        circuit->setMeshCurrents(cachedMeshCurrents);
+    } else {
+        circuit->solveMeshCurrents();
+        auto meshCurrents = circuit->getMeshCurrentsView();
+        for (size_t index = 0; index < branches.size(); ++index) {
+            const LoadBranch& branch = branches[index];
+            branchCurrents[index] = meshCurrents[branch.meshA] + branch.sign * meshCurrents[branch.meshB];
+        }
+        if (cache != nullptr) {
+            cache->insert(key, meshCurrents, branchCurrents);
         }
     }
-    throw std::runtime_error("Other mesh not found for shared load!");
+
+    for (size_t index = 0; index < tableBranches.size(); ++index) {
+        loadCurrents[index] = branchCurrents[tableBranches[index]];
+    }
+    if (table != nullptr) {
+        table->setCurrents(loadIds.data(), loadCurrents.data(), loadIds.size());
+    }
+
+    // Loads kept in another table are updated one by one
+    for (int index : otherBranches) {
+        branches[index].load->setCurrent(branchCurrents[index]);
+    }
+}
+
+// Share solutions of identical circuits through a cache; nullptr disables it
+void Simulator::setSolutionCache(SolutionCache* cache) {
+    this->cache = cache;
 }
@@ -0,0 +1,93 @@
+#include "simulator/SolutionCache.hpp"
+
+// Bookkeeping per entry on top of its current arrays: the list node and the index node
+static constexpr std::size_t ENTRY_OVERHEAD = 96;
+
+// Constructor
+SolutionCache::SolutionCache(std::size_t capacityBytes) 
+    : capacityBytes(capacityBytes), usedBytes(0), hits(0), misses(0) {}
+
+// Copy a cached solution out and mark it as recently used. An entry whose
+// first hash matches but whose full key does not is a collision, not a hit.
+bool SolutionCache::lookup(const CircuitHash::Key& key, std::vector<std::complex<double>>& meshCurrents, 
+                           std::vector<std::complex<double>>& loadCurrents) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = index.find(key.hash);
+    if (found == index.end() || found->second->key != key) {
+        misses++;
+        return false;
+    }
+    hits++;
+    entries.splice(entries.begin(), entries, found->second);
+    meshCurrents.assign(found->second->meshCurrents.begin(), found->second->meshCurrents.end());
+    loadCurrents.assign(found->second->loadCurrents.begin(), found->second->loadCurrents.end());
+    return true;
+}
+
+// Store a solution, evicting the least recently used ones to stay under the cap
+void SolutionCache::insert(const CircuitHash::Key& key, Span<const std::complex<double>> meshCurrents, 
+                           Span<const std::complex<double>> loadCurrents) {
+    std::size_t bytes = sizeof(Entry) + ENTRY_OVERHEAD 
+                      + (meshCurrents.size() + loadCurrents.size()) * sizeof(std::complex<double>);
+    std::lock_guard<std::mutex> lock(mutex);
+    // A colliding entry is replaced as well
+    auto found = index.find(key.hash);
+    if (found != index.end()) {
+        usedBytes -= found->second->bytes;
+        entries.erase(found->second);
+        index.erase(found);
+    }
+    if (bytes > capacityBytes) {
+        return;
+    }
+
+    evictUntil(capacityBytes - bytes);
+    entries.push_front(Entry{key, std::vector<std::complex<double>>(meshCurrents.begin(), meshCurrents.end()), 
+                             std::vector<std::complex<double>>(loadCurrents.begin(), loadCurrents.end()), bytes});
+    index[key.hash] = entries.begin();
+    usedBytes += bytes;
+}
+
+// Evict from the back until the used bytes fit the limit
+void SolutionCache::evictUntil(std::size_t limit) {
+    while (usedBytes > limit && !entries.empty()) {
+        usedBytes -= entries.back().bytes;
+        index.erase(entries.back().key.hash);
+        entries.pop_back();
+    }
+}
+
+// Drop every entry and reset the counters
+void SolutionCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
+    usedBytes = 0;
+    hits = 0;
+    misses = 0;
+}
+
+// Getters
+std::size_t SolutionCache::getHits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+std::size_t SolutionCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+std::size_t SolutionCache::getSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+std::size_t SolutionCache::getUsedBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return usedBytes;
+}
+
+std::size_t SolutionCache::getCapacityBytes() const {
+    return capacityBytes;
+}
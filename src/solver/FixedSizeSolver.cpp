@@ -0,0 +1,44 @@
+#include "solver/FixedSizeSolver.hpp"
+#include <array>
+#include <utility>
+#include <Eigen/Dense>
+
+// Kernel for one compile-time size
+template <typename Scalar, int Columns, int Size>
+static bool solveFixed(const Scalar* matrix, Scalar* rhs) {
+    Eigen::Map<const Eigen::Matrix<Scalar, Size, Size>> system(matrix);
+    Eigen::Map<Eigen::Matrix<Scalar, Size, Columns>> values(rhs);
+    Eigen::PartialPivLU<Eigen::Matrix<Scalar, Size, Size>> lu(system);
+    // Negated so a NaN estimate also counts as singular
+    if (!(lu.rcond() >= LU_RCOND_LIMIT)) {
+        return false;
+    }
+    Eigen::Matrix<Scalar, Size, Columns> solution = lu.solve(values);
+    values = solution;
+    return true;
+}
+
+// Dispatch table indexed by size; entry 0 is unused
+template <typename Scalar, int Columns, int... Sizes>
+static constexpr auto makeKernelTable(std::integer_sequence<int, Sizes...>) {
+    using Kernel = bool (*)(const Scalar*, Scalar*);
+    return std::array<Kernel, sizeof...(Sizes) + 1>{nullptr, &solveFixed<Scalar, Columns, Sizes + 1>...};
+}
+
+// Whether a system of this size has a fixed-size kernel
+template <typename Scalar, int Columns>
+bool FixedSizeSolver<Scalar, Columns>::supports(int size) {
+    return size >= 1 && size <= FIXED_SIZE_SOLVER_LIMIT;
+}
+
+// Solve in place with the kernel of the matching size
+template <typename Scalar, int Columns>
+bool FixedSizeSolver<Scalar, Columns>::solve(int size, const Scalar* matrix, Scalar* rhs) {
+    static constexpr auto kernels = 
+        makeKernelTable<Scalar, Columns>(std::make_integer_sequence<int, FIXED_SIZE_SOLVER_LIMIT>());
+    return kernels[size](matrix, rhs);
+}
+
+// Complex blocks solve one column; real blocks solve the real and imaginary parts together
+template class FixedSizeSolver<std::complex<double>, 1>;
+template class FixedSizeSolver<double, 2>;
@@ -0,0 +1,411 @@
+#include "solver/MeshSolver.hpp"
+#include "constants/Constants.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+// Constructor
+template <typename Scalar>
+BasicMeshSolver<Scalar>::BasicMeshSolver() 
+    : requestedKind(SolverKind::AUTO), kind(SolverKind::AUTO), analyzed(false), factorized(false), 
+      analyzeCount(0), factorizeCount(0) {}
+
+// Symbolic phase: compute the fill-reducing ordering for the current pattern
+template <typename Scalar>
+void BasicMeshSolver<Scalar>::analyze() {
+    sparseSolver.analyzePattern(systemMatrix);
+    analyzed = true;
+    analyzeCount++;
+}
+
+// Numeric phase: pick a factorization for the current values and compute it
+template <typename Scalar>
+void BasicMeshSolver<Scalar>::factorize() {
+    SystemTraits traits = SolverPolicy::inspect(systemMatrix);
+    SolverKind chosen = SolverPolicy::choose(traits, requestedKind);
+
+    if (chosen == SolverKind::SPARSE) {
+        if (!analyzed) {
+            analyze();
+        }
+        sparseSolver.factorize(systemMatrix);
+        if (sparseSolver.info() != Eigen::Success) {
+            throw std::runtime_error("Sparse factorization of the mesh system failed!");
+        }
+    } else {
+        denseMatrix = systemMatrix;
+        if (chosen == SolverKind::DENSE_LDLT) {
+            ldltSolver.compute(denseMatrix);
+            if (!ldltSolver.isSuccessful()) {
+                chosen = SolverKind::DENSE_LU;
+            }
+        }
+        if (chosen == SolverKind::DENSE_LU) {
+            luSolver.compute(denseMatrix);
+            // Near-singular systems are left to the rank-revealing QR unless LU was forced
+            if (requestedKind != SolverKind::DENSE_LU && luSolver.rcond() < LU_RCOND_LIMIT) {
+                chosen = SolverKind::DENSE_QR;
+            }
+        }
+        if (chosen == SolverKind::DENSE_QR) {
+            qrSolver.compute(denseMatrix);
+        }
+    }
+
+    if (chosen != kind) {
+        SolverPolicy::log(traits, chosen);
+    }
+    kind = chosen;
+    clearUpdates();
+    factorized = true;
+    factorizeCount++;
+}
+
+// Compare the structure of a compressed matrix with the cached one
+template <typename Scalar>
+bool BasicMeshSolver<Scalar>::hasSamePattern(const SparseMatrix& matrix) const {
+    if (matrix.rows() != systemMatrix.rows() || matrix.nonZeros() != systemMatrix.nonZeros()) {
+        return false;
+    }
+    return std::equal(matrix.outerIndexPtr(), matrix.outerIndexPtr() + matrix.outerSize() + 1, 
+                      systemMatrix.outerIndexPtr())
+        && std::equal(matrix.innerIndexPtr(), matrix.innerIndexPtr() + matrix.nonZeros(), 
+                      systemMatrix.innerIndexPtr());
+}
+
+// Build the compressed matrix of a system
+template <typename Scalar>
+typename BasicMeshSolver<Scalar>::SparseMatrix BasicMeshSolver<Scalar>::buildMatrix(const std::vector<Triplet>& triplets, 
+                                                                                    int size) const {
+    SparseMatrix matrix(size, size);
+    matrix.setFromTriplets(triplets.begin(), triplets.end());
+    matrix.makeCompressed();
+    return matrix;
+}
+
+// Check that a matrix with the cached pattern differs from the cached one by delta * u * u^T
+template <typename Scalar>
+bool BasicMeshSolver<Scalar>::differsByRankOne(const SparseMatrix& matrix, const Vector& direction, Scalar delta) const {
+    for (int column = 0; column < matrix.outerSize(); ++column) {
+        for (int entry = matrix.outerIndexPtr()[column]; entry < matrix.outerIndexPtr()[column + 1]; ++entry) {
+            int row = matrix.innerIndexPtr()[entry];
+            Scalar expected = delta * direction(row) * direction(column);
+            Scalar actual = matrix.valuePtr()[entry] - systemMatrix.valuePtr()[entry];
+            double scale = std::abs(matrix.valuePtr()[entry]) + std::abs(systemMatrix.valuePtr()[entry]) + std::abs(delta);
+            if (std::abs(actual - expected) > 1e-12 * scale) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Replace the cached system, dropping the symbolic analysis if the pattern changed.
+// Returns whether the cached factorization no longer matches the system.
+template <typename Scalar>
+bool BasicMeshSolver<Scalar>::loadSystem(SparseMatrix matrix, SolverKind requested) {
+    if (requested != requestedKind) {
+        requestedKind = requested;
+        factorized = false;
+    }
+
+    if (!hasSamePattern(matrix)) {
+        // New topology: both phases must be redone
+        systemMatrix = std::move(matrix);
+        tripletCoordinates.clear();
+        analyzed = false;
+        factorized = false;
+    } else if (!std::equal(matrix.valuePtr(), matrix.valuePtr() + matrix.nonZeros(), systemMatrix.valuePtr())) {
+        // Same topology with new impedances: keep the ordering
+        std::copy(matrix.valuePtr(), matrix.valuePtr() + matrix.nonZeros(), systemMatrix.valuePtr());
+        return true;
+    }
+    return !factorized;
+}
+
+// Bring the cached analysis and factorization up to date with a new system
+// Repeated assemblies of the same pattern are scattered straight into the
+// cached matrix, so a steady-state prepare does no allocator work.
+template <typename Scalar>
+void BasicMeshSolver<Scalar>::prepare(const std::vector<Triplet>& triplets, int size, SolverKind requested) {
+    if (requested != requestedKind) {
+        requestedKind = requested;
+        factorized = false;
+    }
+
+    if (scatterValues(triplets, size)) {
+        // Same topology: refactor only if an impedance changed
+        if (!std::equal(scatteredValues.begin(), scatteredValues.end(), systemMatrix.valuePtr())) {
+            std::copy(scatteredValues.begin(), scatteredValues.end(), systemMatrix.valuePtr());
+            factorized = false;
+        }
+        if (!factorized) {
+            factorize();
+        }
+        return;
+    }
+
+    if (loadSystem(buildMatrix(triplets, size), requested)) {
+        factorize();
+    }
+    recordPositions(triplets);
+}
+
+// Sum the triplets into their recorded positions, if they have the recorded coordinates
+template <typename Scalar>
+bool BasicMeshSolver<Scalar>::scatterValues(const std::vector<Triplet>& triplets, int size) {
+    if (size != systemMatrix.rows() || triplets.size() != tripletCoordinates.size()) {
+        return false;
+    }
+    for (size_t index = 0; index < triplets.size(); ++index) {
+        if (triplets[index].row() != tripletCoordinates[index].first 
+            || triplets[index].col() != tripletCoordinates[index].second) {
+            return false;
+        }
+    }
+
+    std::fill(scatteredValues.begin(), scatteredValues.end(), Scalar(0));
+    for (size_t index = 0; index < triplets.size(); ++index) {
+        scatteredValues[tripletPositions[index]] += triplets[index].value();
+    }
+    return true;
+}
+
+// Remember where each triplet lands in the compressed cached matrix
+template <typename Scalar>
+void BasicMeshSolver<Scalar>::recordPositions(const std::vector<Triplet>& triplets) {
+    tripletCoordinates.resize(triplets.size());
+    tripletPositions.resize(triplets.size());
+    scatteredValues.resize(systemMatrix.nonZeros());
+    const int* outer = systemMatrix.outerIndexPtr();
+    const int* inner = systemMatrix.innerIndexPtr();
+    for (size_t index = 0; index < triplets.size(); ++index) {
+        int row = triplets[index].row();
+        int column = triplets[index].col();
+        tripletCoordinates[index] = {row, column};
+        tripletPositions[index] = std::lower_bound(inner + outer[column], inner + outer[column + 1], row) - inner;
+    }
+}
+
+// Move to a new system that differs from the prepared one by a symmetric rank-one term.
+// Anything else (another load changed meanwhile, a new pattern) falls back to a refactor.
+template <typename Scalar>
+void BasicMeshSolver<Scalar>::update(const std::vector<Triplet>& triplets, int size, SolverKind requested, 
+                                     const Vector& direction, Scalar delta) {
+    SparseMatrix matrix = buildMatrix(triplets, size);
+    bool isLowRank = factorized && requested == requestedKind && getUpdateRank() < MAX_LOW_RANK_UPDATES 
+                  && hasSamePattern(matrix) && differsByRankOne(matrix, direction, delta);
+    if (!loadSystem(std::move(matrix), requested)) {
+        return;
+    }
+    if (!isLowRank) {
+        factorize();
+        return;
+    }
+
+    // Woodbury: keep A^-1 u for the new direction and refresh the small capacitance matrix
+    int rank = getUpdateRank();
+    updateDirections.conservativeResize(size, rank + 1);
+    updateSolutions.conservativeResize(size, rank + 1);
+    updateWeights.conservativeResize(rank + 1);
+    updateDirections.col(rank) = direction;
+    solveFactorizedColumn(direction, updateSolutions.col(rank));
+    updateWeights(rank) = delta;
+
+    Matrix capacitance = updateDirections.transpose() * updateSolutions;
+    capacitance.diagonal() += updateWeights.cwiseInverse();
+    capacitanceSolver.compute(capacitance);
+}
+
+// Solve one column with the cached factorization only. Every temporary is a solve
+// buffer of the solver, resized in place, and Eigen's triangular solves take their
+// vector path, which needs no scratch memory: a repeated solve does not allocate.
+template <typename Scalar>
+void BasicMeshSolver<Scalar>::solveFactorizedColumn(const Eigen::Ref<const Vector>& rhs, 
+                                                    Eigen::Ref<Vector> solution) const {
+    switch (kind) {
+        case SolverKind::SPARSE:
+            // x = Pc^T U^-1 L^-1 Pr b, permuting between two buffers instead of in place
+            columnBuffer = sparseSolver.rowsPermutation() * rhs;
+            solveSparseLower(columnBuffer);
+            sparseSolver.matrixU().solveInPlace(columnBuffer);
+            solution = sparseSolver.colsPermutation().inverse() * columnBuffer;
+            break;
+        case SolverKind::DENSE_LDLT:
+            solution = rhs;
+            ldltSolver.solveInPlace(solution);
+            break;
+        case SolverKind::DENSE_LU:
+            solution = luSolver.permutationP() * rhs;
+            luSolver.matrixLU().template triangularView<Eigen::UnitLower>().solveInPlace(solution);
+            luSolver.matrixLU().template triangularView<Eigen::Upper>().solveInPlace(solution);
+            break;
+        default:
+            solveQr(rhs, solution);
+            break;
+    }
+}
+
+// Forward substitution with the unit lower factor of the sparse LU. This is Eigen's
+// supernodal solve, with the products of each supernode kept in a solve buffer.
+template <typename Scalar>
+void BasicMeshSolver<Scalar>::solveSparseLower(Vector& x) const {
+    using Supernodes = typename SparseSolver::SCMatrix;
+    using Panel = Eigen::Map<const Matrix, 0, Eigen::OuterStride<>>;
+    const Supernodes& lower = sparseSolver.matrixL().m_mapL;
+    supernodeBuffer.resize(x.size());
+
+    for (Eigen::Index supernode = 0; supernode <= lower.nsuper(); ++supernode) {
+        Eigen::Index firstColumn = lower.supToCol()[supernode];
+        Eigen::Index numColumns = lower.supToCol()[supernode + 1] - firstColumn;
+        Eigen::Index firstRow = lower.rowIndexPtr()[firstColumn];
+        Eigen::Index numBelow = lower.rowIndexPtr()[firstColumn + 1] - firstRow - numColumns;
+
+        // Single column: subtract it below the diagonal
+        if (numColumns == 1) {
+            typename Supernodes::InnerIterator entry(lower, firstColumn);
+            for (++entry; entry; ++entry) {
+                x(entry.row()) -= x(firstColumn) * entry.value();
+            }
+            continue;
+        }
+
+        // Dense triangle of the supernode, then its rows below scattered back
+        Eigen::Index offset = lower.colIndexPtr()[firstColumn];
+        Eigen::OuterStride<> stride(lower.colIndexPtr()[firstColumn + 1] - offset);
+        Panel triangle(lower.valuePtr() + offset, numColumns, numColumns, stride);
+        Panel below(lower.valuePtr() + offset + numColumns, numBelow, numColumns, stride);
+        auto head = x.segment(firstColumn, numColumns);
+        triangle.template triangularView<Eigen::UnitLower>().solveInPlace(head);
+        supernodeBuffer.head(numBelow).noalias() = below * head;
+        for (Eigen::Index row = 0; row < numBelow; ++row) {
+            x(lower.rowIndex()[firstRow + numColumns + row]) -= supernodeBuffer(row);
+        }
+    }
+}
+
+// Least-squares solve with the column-pivoted QR: x = P R^-1 Q^H b over its nonzero
+// pivots. Q^H b is the reflectors of the factorization applied to b in the same order.
+template <typename Scalar>
+void BasicMeshSolver<Scalar>::solveQr(const Eigen::Ref<const Vector>& rhs, Eigen::Ref<Vector> solution) const {
+    const Matrix& factors = qrSolver.matrixQR();
+    Eigen::Index rank = qrSolver.nonzeroPivots();
+    Eigen::Index size = rhs.size();
+    columnBuffer = rhs;
+
+    Scalar workspace;
+    for (Eigen::Index reflector = 0; reflector < rank; ++reflector) {
+        Eigen::Index length = size - reflector;
+        columnBuffer.tail(length).applyHouseholderOnTheLeft(factors.col(reflector).tail(length - 1), 
+                                                            qrSolver.hCoeffs()(reflector), &workspace);
+    }
+    factors.topLeftCorner(rank, rank).template triangularView<Eigen::Upper>().solveInPlace(columnBuffer.head(rank));
+
+    const auto& columns = qrSolver.colsPermutation().indices();
+    for (Eigen::Index row = 0; row < size; ++row) {
+        solution(columns(row)) = row < rank ? columnBuffer(row) : Scalar(0);
+    }
+}
+
+// Solve every column: the cached factorization, then the Woodbury correction
+// x -= (A^-1 U) C^-1 U^T x of the low-rank terms, if any
+template <typename Scalar>
+template <typename Rhs, typename Destination>
+void BasicMeshSolver<Scalar>::solveInto(const Rhs& rhs, Destination& solution) const {
+    if (!factorized) {
+        throw std::runtime_error("Mesh solver used before being prepared!");
+    }
+    solution.resize(rhs.rows(), rhs.cols());
+    for (Eigen::Index column = 0; column < rhs.cols(); ++column) {
+        solveFactorizedColumn(rhs.col(column), solution.col(column));
+        if (getUpdateRank() > 0) {
+            updateProjection.noalias() = updateDirections.transpose() * solution.col(column);
+            updateCoefficients = capacitanceSolver.solve(updateProjection);
+            solution.col(column).noalias() -= updateSolutions * updateCoefficients;
+        }
+    }
+}
+
+// Forget the low-rank terms
+template <typename Scalar>
+void BasicMeshSolver<Scalar>::clearUpdates() {
+    updateDirections.resize(0, 0);
+    updateSolutions.resize(0, 0);
+    updateWeights.resize(0);
+}
+
+// Solve the prepared system for a right-hand side
+template <typename Scalar>
+typename BasicMeshSolver<Scalar>::Vector BasicMeshSolver<Scalar>::solve(const Vector& rhs) const {
+    Vector solution;
+    solveInto(rhs, solution);
+    return solution;
+}
+
+// Solve the prepared system for several right-hand sides at once
+template <typename Scalar>
+typename BasicMeshSolver<Scalar>::Matrix BasicMeshSolver<Scalar>::solve(const Matrix& rhs) const {
+    Matrix solution;
+    solveInto(rhs, solution);
+    return solution;
+}
+
+// Solve into caller-owned storage, reused when it already has the right size
+template <typename Scalar>
+void BasicMeshSolver<Scalar>::solve(const Vector& rhs, Vector& solution) const {
+    solveInto(rhs, solution);
+}
+
+template <typename Scalar>
+void BasicMeshSolver<Scalar>::solve(const Matrix& rhs, Matrix& solution) const {
+    solveInto(rhs, solution);
+}
+
+// Drop every cached phase
+template <typename Scalar>
+void BasicMeshSolver<Scalar>::reset() {
+    analyzed = false;
+    factorized = false;
+    systemMatrix.resize(0, 0);
+    tripletCoordinates.clear();
+    clearUpdates();
+}
+
+// Getters
+template <typename Scalar>
+SolverKind BasicMeshSolver<Scalar>::getKind() const {
+    return kind;
+}
+
+template <typename Scalar>
+bool BasicMeshSolver<Scalar>::isSparse() const {
+    return kind == SolverKind::SPARSE;
+}
+
+template <typename Scalar>
+bool BasicMeshSolver<Scalar>::isFactorized() const {
+    return factorized;
+}
+
+template <typename Scalar>
+int BasicMeshSolver<Scalar>::getSize() const {
+    return systemMatrix.rows();
+}
+
+template <typename Scalar>
+int BasicMeshSolver<Scalar>::getUpdateRank() const {
+    return updateWeights.size();
+}
+
+template <typename Scalar>
+int BasicMeshSolver<Scalar>::getAnalyzeCount() const {
+    return analyzeCount;
+}
+
+template <typename Scalar>
+int BasicMeshSolver<Scalar>::getFactorizeCount() const {
+    return factorizeCount;
+}
+
+// Real systems for resistive circuits, complex ones for everything else
+template class BasicMeshSolver<double>;
+template class BasicMeshSolver<std::complex<double>>;
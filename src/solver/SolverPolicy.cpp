@@ -0,0 +1,98 @@
+#include "solver/SolverPolicy.hpp"
+#include "constants/Constants.hpp"
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+std::ostream* SolverPolicy::logStream = nullptr;
+
+// Serializes writes to the log stream and changes of it; blocks may be solved in parallel
+static std::mutex logMutex;
+
+// Inspect a compressed real or complex system
+template <typename Scalar>
+SystemTraits SolverPolicy::inspect(const Eigen::SparseMatrix<Scalar>& matrix) {
+    SystemTraits traits;
+    traits.size = matrix.rows();
+    traits.nonZeros = matrix.nonZeros();
+
+    // Symmetry without conjugation: mesh impedance matrices are complex symmetric
+    Eigen::SparseMatrix<Scalar> transposed = matrix.transpose();
+    traits.symmetric = (matrix - transposed).norm() == 0.0;
+
+    // Row dominance: |a_ii| >= sum of |a_ij| over the rest of the row
+    std::vector<double> diagonal(traits.size, 0.0);
+    std::vector<double> offDiagonal(traits.size, 0.0);
+    for (int column = 0; column < matrix.outerSize(); ++column) {
+        for (typename Eigen::SparseMatrix<Scalar>::InnerIterator entry(matrix, column); entry; ++entry) {
+            (entry.row() == entry.col() ? diagonal : offDiagonal)[entry.row()] += std::abs(entry.value());
+        }
+    }
+    traits.diagonallyDominant = true;
+    for (int row = 0; row < traits.size; ++row) {
+        if (diagonal[row] == 0.0 || diagonal[row] < offDiagonal[row]) {
+            traits.diagonallyDominant = false;
+            break;
+        }
+    }
+    return traits;
+}
+
+template SystemTraits SolverPolicy::inspect(const Eigen::SparseMatrix<double>& matrix);
+template SystemTraits SolverPolicy::inspect(const Eigen::SparseMatrix<std::complex<double>>& matrix);
+
+// Resolve a requested kind into a concrete factorization
+SolverKind SolverPolicy::choose(const SystemTraits& traits, SolverKind requested) {
+    if (requested != SolverKind::AUTO && requested != SolverKind::DENSE) {
+        return requested;
+    }
+
+    // Large systems with few entries per row are cheaper to factor sparsely
+    double density = traits.size > 0 ? static_cast<double>(traits.nonZeros) / traits.size / traits.size : 1.0;
+    if (requested == SolverKind::AUTO && traits.size >= SPARSE_SOLVER_THRESHOLD && density <= SPARSE_DENSITY_LIMIT) {
+        return SolverKind::SPARSE;
+    }
+
+    // Half the work of LU, stable without pivoting when the system is dominant.
+    // Weak dominance allows near-singular systems; their tiny pivots fail the
+    // factorization, which then falls back to LU and its QR guard.
+    if (traits.symmetric && traits.diagonallyDominant) {
+        return SolverKind::DENSE_LDLT;
+    }
+    return SolverKind::DENSE_LU;
+}
+
+// Write one line describing a selection to the log stream, if any
+void SolverPolicy::log(const SystemTraits& traits, SolverKind chosen) {
+    std::ostringstream line;
+    line << "[SolverPolicy] size=" << traits.size 
+         << " nnz=" << traits.nonZeros 
+         << (traits.symmetric ? " symmetric" : " unsymmetric") 
+         << (traits.diagonallyDominant ? " dominant" : "") 
+         << " -> " << getName(chosen) << '\n';
+
+    // The line is written whole, so lines from parallel solves never interleave
+    std::lock_guard<std::mutex> lock(logMutex);
+    if (logStream != nullptr) {
+        *logStream << line.str() << std::flush;
+    }
+}
+
+// Return the printable name of a kind
+const char* SolverPolicy::getName(SolverKind kind) {
+    switch (kind) {
+        case SolverKind::AUTO:       return "AUTO";
+        case SolverKind::DENSE:      return "DENSE";
+        case SolverKind::SPARSE:     return "SPARSE_LU";
+        case SolverKind::DENSE_LU:   return "DENSE_LU";
+        case SolverKind::DENSE_LDLT: return "DENSE_LDLT";
+        case SolverKind::DENSE_QR:   return "DENSE_QR";
+    }
+    return "UNKNOWN";
+}
+
+// Send selection logs to a stream, or disable them with nullptr
+void SolverPolicy::setLogStream(std::ostream* stream) {
+    std::lock_guard<std::mutex> lock(logMutex);
+    logStream = stream;
+}
@@ -0,0 +1,71 @@
+#include "solver/SymmetricLDLT.hpp"
+#include "constants/Constants.hpp"
+
+// Constructor
+template <typename Scalar>
+SymmetricLDLT<Scalar>::SymmetricLDLT() : factors(), success(false) {}
+
+// Factorize a matrix column by column; only its lower triangle is read. Without
+// pivoting, a tiny pivot means the matrix is close to singular, so pivots below
+// LDLT_PIVOT_LIMIT times its largest absolute row sum fail the factorization.
+template <typename Scalar>
+void SymmetricLDLT<Scalar>::compute(const Matrix& matrix) {
+    int size = matrix.rows();
+    factors = matrix.template triangularView<Eigen::Lower>();
+    // Row sums of the symmetric matrix: its lower row plus its lower column, minus the diagonal counted twice
+    double threshold = size == 0 ? 0.0 : LDLT_PIVOT_LIMIT * (factors.cwiseAbs().rowwise().sum() 
+                                                             + factors.cwiseAbs().colwise().sum().transpose() 
+                                                             - factors.diagonal().cwiseAbs()).maxCoeff();
+    success = true;
+
+    Vector scaledRow(size);
+    for (int column = 0; column < size; ++column) {
+        // scaledRow = L(column, 0:column) .* D(0:column)
+        scaledRow.head(column) = factors.row(column).head(column).transpose()
+                                 .cwiseProduct(factors.diagonal().head(column));
+
+        Scalar pivot = factors(column, column) 
+                     - (factors.row(column).head(column) * scaledRow.head(column)).value();
+        if (!(std::abs(pivot) > threshold)) {
+            success = false;
+            return;
+        }
+        factors(column, column) = pivot;
+
+        int below = size - column - 1;
+        if (below > 0) {
+            factors.col(column).tail(below) -= factors.bottomLeftCorner(below, column) * scaledRow.head(column);
+            factors.col(column).tail(below) /= pivot;
+        }
+    }
+}
+
+// Solve L * D * L^T * x = rhs
+template <typename Scalar>
+typename SymmetricLDLT<Scalar>::Matrix SymmetricLDLT<Scalar>::solve(const Matrix& rhs) const {
+    Matrix solution = rhs;
+    solveInPlace(solution);
+    return solution;
+}
+
+// Overwrite right-hand sides with their solutions. One column at a time: Eigen solves
+// a triangular system for a vector in place, but blocks a matrix through scratch memory.
+template <typename Scalar>
+void SymmetricLDLT<Scalar>::solveInPlace(Eigen::Ref<Matrix> solution) const {
+    for (Eigen::Index column = 0; column < solution.cols(); ++column) {
+        auto x = solution.col(column);
+        factors.template triangularView<Eigen::UnitLower>().solveInPlace(x);
+        x = x.cwiseQuotient(factors.diagonal());
+        factors.transpose().template triangularView<Eigen::UnitUpper>().solveInPlace(x);
+    }
+}
+
+// Getters
+template <typename Scalar>
+bool SymmetricLDLT<Scalar>::isSuccessful() const {
+    return success;
+}
+
+// Real systems for resistive circuits, complex ones for everything else
+template class SymmetricLDLT<double>;
+template class SymmetricLDLT<std::complex<double>>;
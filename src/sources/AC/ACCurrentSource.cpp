@@ -4,4 +4,4 @@
 ACCurrentSource::ACCurrentSource(double firstValue, double secondValue, double thirdValue, 
                                  ACSource::ValueRepresentation valueMode, 
                                  ACSource::FrequencyRepresentation freqMode)
-    : ACSource(firstValue, secondValue, thirdValue, valueMode, freqMode) {}
+    : ACSource(SourceKind::AC_CURRENT, firstValue, secondValue, thirdValue, valueMode, freqMode) {}
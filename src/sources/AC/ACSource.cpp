@@ -1,8 +1,10 @@
 #include "sources/AC/ACSource.hpp"
+#include <cmath>
 
 // Constructor using amplitude, frequency, and phase
-ACSource::ACSource(double firstValue, double secondValue, double thirdValue, 
-                    ValueRepresentation valueMode, FrequencyRepresentation freqMode) {
+ACSource::ACSource(SourceKind kind, double firstValue, double secondValue, double thirdValue, 
+                    ValueRepresentation valueMode, FrequencyRepresentation freqMode) 
+    : Source(kind) {
 
     // Handle value representation
     switch (valueMode) {
@@ -42,10 +44,14 @@ ACSource::ACSource(double firstValue, double secondValue, double thirdValue,
 }
 
 // Getters
-double ACSource::getFrequency() {
+double ACSource::getFrequency() const {
     return this->frequency;
 }
 
 std::complex<double> ACSource::getValue() {
     return this->phasor;
 }
+
+double ACSource::getValueAt(double time) const {
+    return this->amplitude * std::cos(this->angularFrequency * time + this->phase);
+}
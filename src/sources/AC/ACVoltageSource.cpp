@@ -4,4 +4,4 @@
 ACVoltageSource::ACVoltageSource(double firstValue, double secondValue, double thirdValue, 
                                  ACSource::ValueRepresentation valueMode, 
                                  ACSource::FrequencyRepresentation freqMode)
-    : ACSource(firstValue, secondValue, thirdValue, valueMode, freqMode) {}
+    : ACSource(SourceKind::AC_VOLTAGE, firstValue, secondValue, thirdValue, valueMode, freqMode) {}
@@ -2,4 +2,4 @@
 
 // Constructor
 DCCurrentSource::DCCurrentSource(double value)
-    : DCSource(value) {}
+    : DCSource(SourceKind::DC_CURRENT, value) {}
@@ -1,10 +1,15 @@
 #include "sources/DC/DCSource.hpp"
 
 // Constructor
-DCSource::DCSource(double value) {
+DCSource::DCSource(SourceKind kind, double value) 
+    : Source(kind) {
     this->value = value;
 }
 
 std::complex<double> DCSource::getValue() {
     return std::complex<double>(this->value, 0.0);
 }
+
+double DCSource::getValueAt(double /*time*/) const {
+    return this->value;
+}
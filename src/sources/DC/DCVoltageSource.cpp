@@ -2,4 +2,4 @@
 
 // Constructor
 DCVoltageSource::DCVoltageSource(double value)
-    : DCSource(value) {}
+    : DCSource(SourceKind::DC_VOLTAGE, value) {}
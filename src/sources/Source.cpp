@@ -0,0 +1,23 @@
+#include "sources/Source.hpp"
+
+// Constructor
+Source::Source(SourceKind kind) 
+    : kind(kind) {}
+
+// Getters
+SourceKind Source::getKind() const {
+    return kind;
+}
+
+bool Source::isVoltageSource() const {
+    return kind == SourceKind::AC_VOLTAGE || kind == SourceKind::DC_VOLTAGE;
+}
+
+bool Source::isCurrentSource() const {
+    return kind == SourceKind::AC_CURRENT || kind == SourceKind::DC_CURRENT;
+}
+
+// DC sources have no frequency
+double Source::getFrequency() const {
+    return 0.0;
+}
@@ -0,0 +1,112 @@
+// Test includes
+#include "TestCircuits.hpp"
+#include "simulator/Simulator.hpp"
+// General C++ includes
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// Every heap allocation of the program goes through malloc, calloc or realloc:
+// operator new as well as Eigen's aligned_malloc. These replace the C library's
+// entry points and count calls before handing them to glibc's implementation.
+extern "C" void* __libc_malloc(std::size_t size);
+extern "C" void* __libc_calloc(std::size_t count, std::size_t size);
+extern "C" void* __libc_realloc(void* memory, std::size_t size);
+
+static std::atomic<long> allocationCount(0);
+
+extern "C" void* malloc(std::size_t size) {
+    allocationCount++;
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(std::size_t count, std::size_t size) {
+    allocationCount++;
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* memory, std::size_t size) {
+    allocationCount++;
+    return __libc_realloc(memory, size);
+}
+
+// Allocations made by a task
+template <typename Task>
+static long countAllocations(Task&& task) {
+    long before = allocationCount;
+    task();
+    return allocationCount - before;
+}
+
+// Name of a solver mode for the report
+static const char* getModeName(SolverKind mode) {
+    switch (mode) {
+        case SolverKind::AUTO:       return "auto";
+        case SolverKind::SPARSE:     return "sparse LU";
+        case SolverKind::DENSE_LU:   return "dense LU";
+        case SolverKind::DENSE_LDLT: return "LDLT";
+        case SolverKind::DENSE_QR:   return "QR";
+        default:                     return "dense";
+    }
+}
+
+// A solve with an unchanged topology reads it through the span views and
+// reuses every workspace and solver buffer, so it must not allocate at all;
+// neither must a simulation, which only adds the batched load update on top
+// of the solve. Checked for every factorization, in complex arithmetic and in
+// real arithmetic with complex sources, on the fixed-size kernels, the dense
+// factorizations and sparse LU.
+int main() {
+    int failures = 0;
+
+    // The counter must see both kinds of heap traffic, or a zero below means nothing
+    long vectorAllocations = countAllocations([] { std::make_unique<std::vector<int>>(16); });
+    long eigenAllocations = countAllocations([] { Eigen::VectorXcd vector(16); vector.setZero(); });
+    if (vectorAllocations == 0 || eigenAllocations == 0) {
+        std::cout << "Allocation counter does not see operator new or Eigen" << std::endl;
+        failures++;
+    }
+
+    for (int width : {2, 6, 20}) {
+        for (bool resistive : {false, true}) {
+            for (SolverKind mode : {SolverKind::AUTO, SolverKind::SPARSE, SolverKind::DENSE_LU,
+                                    SolverKind::DENSE_LDLT, SolverKind::DENSE_QR}) {
+                CircuitBuilder builder;
+                Circuit* circuit = buildGrid(builder, width);
+                circuit->setParallelSolve(false);
+                circuit->setSolverMode(mode);
+                if (resistive) {
+                    const LoadIncidence& loads = circuit->getLoadIncidence();
+                    for (int loadIndex = 0; loadIndex < loads.getNumLoads(); loadIndex++) {
+                        Load* load = loads.getLoad(loadIndex);
+                        load->setImpedance(std::abs(load->getImpedance()));
+                    }
+                }
+                circuit->solveMeshCurrents();
+                circuit->solveMeshCurrents();
+                long solveAllocations = countAllocations([circuit] { circuit->solveMeshCurrents(); });
+
+                Simulator simulator(circuit);
+                simulator.runSimulation();
+                simulator.runSimulation();
+                long simulationAllocations = countAllocations([&simulator] { simulator.runSimulation(); });
+
+                std::cout << width * width << " meshes, " << (resistive ? "resistive, " : "") << getModeName(mode)
+                          << ": " << solveAllocations << " allocations per warm solve, "
+                          << simulationAllocations << " per warm simulation" << std::endl;
+                if (solveAllocations != 0 || simulationAllocations != 0) {
+                    failures++;
+                }
+            }
+        }
+    }
+
+    if (failures > 0) {
+        std::cout << "AllocationTest failed!" << std::endl;
+        return 1;
+    }
+    std::cout << "AllocationTest passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Test includes
+#include "TestCircuits.hpp"
+#include "circuit/CircuitSnapshot.hpp"
+#include "constants/Constants.hpp"
+#include "load/components/Capacitor.hpp"
+#include "load/components/Inductor.hpp"
+#include "load/components/Resistor.hpp"
+#include "sources/AC/ACCurrentSource.hpp"
+#include "sources/DC/DCVoltageSource.hpp"
+// General C++ includes
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static std::vector<char> readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static void writeFile(const std::string& path, const std::vector<char>& bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), bytes.size());
+}
+
+// Message of the error opening and building a snapshot throws, or an empty string
+static std::string openError(const std::string& path) {
+    try {
+        CircuitSnapshot snapshot(path);
+        CircuitBuilder builder;
+        snapshot.build(builder);
+    } catch (const std::runtime_error& error) {
+        return error.what();
+    }
+    return "";
+}
+
+// Byte offset of an array of the snapshot in its file
+template <typename T>
+static std::size_t fileOffset(const CircuitSnapshot& snapshot, Span<const T> section) {
+    return reinterpret_cast<const char*>(section.data()) - reinterpret_cast<const char*>(&snapshot.getHeader());
+}
+
+// A grid with a few components and an AC current source shared by two
+// meshes is saved, reopened and rebuilt; the rebuilt circuit must hold the
+// same loads and solve to the same currents. Then copies of the file with
+// corrupt offsets, an index out of range and missing bytes must be rejected.
+int main() {
+    const std::string path = (std::filesystem::temp_directory_path() / "CircuitSnapshotTest.snap").string();
+    const std::string copyPath = path + ".corrupt";
+    int failures = 0;
+
+    CircuitBuilder builder;
+    Circuit* original = buildGrid(builder, 6);
+    {
+        Mesh* first = builder.addMesh();
+        Mesh* second = builder.addMesh();
+        Mesh* third = builder.addMesh();
+        Load* capacitor = builder.addLoad<Capacitor>(1e-4, 2.0 * PI * 60.0);
+        first->addSource(builder.addSource<DCVoltageSource>(12.0));
+        first->addLoad(builder.addLoad<Resistor>(5.0));
+        first->addLoad(builder.addLoad<Inductor>(1e-3, 2.0 * PI * 60.0));
+        first->addLoad(capacitor);
+        second->addLoad(capacitor);
+        second->addLoad(builder.addLoad<Resistor>(8.0));
+        third->addLoad(builder.addLoad<Resistor>(3.0));
+        Source* currentSource = builder.addSource<ACCurrentSource>(0.5, 30.0, 60.0);
+        second->addSource(currentSource);
+        third->addSource(currentSource);
+    }
+    original->solveMeshCurrents();
+    std::vector<std::complex<double>> expected = original->getMeshCurrents();
+    CircuitSnapshot::save(*original, path);
+
+    // Round trip
+    {
+        CircuitSnapshot snapshot(path);
+        CircuitBuilder rebuiltBuilder;
+        Circuit* rebuilt = snapshot.build(rebuiltBuilder);
+        const LoadIncidence& before = original->getLoadIncidence();
+        const LoadIncidence& after = rebuilt->getLoadIncidence();
+        bool matches = before.getNumLoads() == after.getNumLoads()
+                    && original->getMeshesView().size() == rebuilt->getMeshesView().size();
+        for (int index = 0; matches && index < before.getNumLoads(); index++) {
+            matches = before.getLoad(index)->getImpedance() == after.getLoad(index)->getImpedance()
+                   && std::equal(before.meshesBegin(index), before.meshesEnd(index),
+                                 after.meshesBegin(index), after.meshesEnd(index));
+        }
+        if (matches) {
+            rebuilt->solveMeshCurrents();
+            std::vector<std::complex<double>> currents = rebuilt->getMeshCurrents();
+            for (std::size_t index = 0; matches && index < currents.size(); ++index) {
+                matches = std::abs(currents[index] - expected[index]) <= 1e-12 * std::abs(expected[index]);
+            }
+        }
+        std::cout << "round trip: " << (matches ? "identical" : "different") << std::endl;
+        if (!matches) {
+            failures++;
+        }
+    }
+
+    // Corrupt copies
+    std::vector<char> bytes = readFile(path);
+    std::size_t meshLoadOffsets;
+    std::size_t loadMeshIndices;
+    {
+        CircuitSnapshot snapshot(path);
+        meshLoadOffsets = fileOffset(snapshot, snapshot.getMeshLoadOffsets());
+        loadMeshIndices = fileOffset(snapshot, snapshot.getLoadMeshIndices());
+    }
+    auto expectError = [&](const char* name, const std::vector<char>& corrupt, const std::string& fragment) {
+        writeFile(copyPath, corrupt);
+        std::string message = openError(copyPath);
+        std::cout << name << ": \"" << message << "\"" << std::endl;
+        if (message.find(fragment) == std::string::npos) {
+            failures++;
+        }
+    };
+    {
+        // The second mesh ends before it starts
+        std::vector<char> corrupt = bytes;
+        std::int32_t offset = -1;
+        std::memcpy(corrupt.data() + meshLoadOffsets + sizeof(std::int32_t), &offset, sizeof(offset));
+        expectError("decreasing offsets", corrupt, "corrupt offsets or indices");
+    }
+    {
+        // The first load lies in a mesh that does not exist
+        std::vector<char> corrupt = bytes;
+        std::int32_t index = 1000000;
+        std::memcpy(corrupt.data() + loadMeshIndices, &index, sizeof(index));
+        expectError("index out of range", corrupt, "corrupt offsets or indices");
+    }
+    expectError("truncated arrays", std::vector<char>(bytes.begin(), bytes.end() - 8), "truncated");
+    expectError("truncated header", std::vector<char>(bytes.begin(), bytes.begin() + 16), "truncated");
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(copyPath);
+    if (failures > 0) {
+        std::cout << "CircuitSnapshotTest failed!" << std::endl;
+        return 1;
+    }
+    std::cout << "CircuitSnapshotTest passed" << std::endl;
+    return 0;
+}
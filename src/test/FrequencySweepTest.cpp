@@ -0,0 +1,121 @@
+// Test includes
+#include "TestCircuits.hpp"
+#include "analysis/FrequencySweep.hpp"
+#include "constants/Constants.hpp"
+#include "load/components/Capacitor.hpp"
+#include "load/components/Inductor.hpp"
+#include "load/components/Resistor.hpp"
+// General C++ includes
+#include <algorithm>
+#include <complex>
+#include <iostream>
+#include <vector>
+
+// Square grid of meshes with a resistor in each, inductors shared between
+// horizontal neighbours, capacitors shared between vertical ones and a source
+// in every third mesh, so that the currents change with the frequency
+static Circuit* buildNetwork(CircuitBuilder& builder, int width, std::vector<Component*>& components) {
+    const double angularFrequency = 2 * PI * 60.0;
+    std::vector<Mesh*> meshes(width * width);
+    for (Mesh*& mesh : meshes) {
+        mesh = builder.addMesh();
+    }
+    for (int row = 0; row < width; row++) {
+        for (int column = 0; column < width; column++) {
+            Mesh* mesh = meshes[row * width + column];
+            Resistor* resistor = builder.addLoad<Resistor>(10.0 + column + row);
+            mesh->addLoad(resistor);
+            components.push_back(resistor);
+            if (column + 1 < width) {
+                Inductor* shared = builder.addLoad<Inductor>(0.01 * (1 + row), angularFrequency);
+                mesh->addLoad(shared);
+                meshes[row * width + column + 1]->addLoad(shared);
+                components.push_back(shared);
+            }
+            if (row + 1 < width) {
+                Capacitor* shared = builder.addLoad<Capacitor>(1e-4 * (1 + column), angularFrequency);
+                mesh->addLoad(shared);
+                meshes[(row + 1) * width + column]->addLoad(shared);
+                components.push_back(shared);
+            }
+            if ((row + column) % 3 == 0) {
+                mesh->addSource(builder.addSource<ACVoltageSource>(10.0, 10.0 * column, 60.0));
+            }
+        }
+    }
+    return builder.getCircuit();
+}
+
+// Sweeps of a small and a larger RLC grid against setting the angular frequency
+// of every component and solving point by point. Every frequency of the grid must
+// reach the callback exactly once, under its own index, and the collected matrix
+// must hold the same currents as the stream.
+int main() {
+    const double tolerance = 1e-12;
+    int failures = 0;
+
+    for (int width : {2, 8}) {
+        std::vector<Component*> components;
+        CircuitBuilder builder;
+        Circuit* circuit = buildNetwork(builder, width, components);
+        int numMeshes = width * width;
+
+        // An odd point count so that the points do not split evenly over the workers
+        FrequencySweep sweep(circuit, FrequencySweep::logGrid(1.0, 1e5, 37));
+        const std::vector<double>& frequencies = sweep.getFrequencies();
+        int numPoints = frequencies.size();
+
+        std::vector<int> deliveries(numPoints, 0);
+        bool wrongFrequency = false;
+        Eigen::MatrixXcd streamed(numMeshes, numPoints);
+        sweep.run([&](int pointIndex, double frequency, const std::vector<std::complex<double>>& meshCurrents) {
+            if (pointIndex < 0 || pointIndex >= numPoints || frequency != frequencies[pointIndex]
+                || static_cast<int>(meshCurrents.size()) != numMeshes) {
+                wrongFrequency = true;
+                return;
+            }
+            deliveries[pointIndex]++;
+            streamed.col(pointIndex) = Eigen::Map<const Eigen::VectorXcd>(meshCurrents.data(), numMeshes);
+        });
+        Eigen::MatrixXcd collected = sweep.run();
+
+        bool deliveredOnce = !wrongFrequency
+            && std::all_of(deliveries.begin(), deliveries.end(), [](int count) { return count == 1; });
+        if (!deliveredOnce) {
+            std::cout << width << "x" << width << " grid: frequencies not delivered exactly once" << std::endl;
+            failures++;
+            continue;
+        }
+
+        double error = 0.0;
+        for (int point = 0; point < numPoints; point++) {
+            for (Component* component : components) {
+                component->setAngularFrequency(2 * PI * frequencies[point]);
+            }
+            circuit->solveMeshCurrents();
+            std::vector<std::complex<double>> expected = circuit->getMeshCurrents();
+            double scale = 0.0;
+            for (const std::complex<double>& current : expected) {
+                scale = std::max(scale, std::abs(current));
+            }
+            for (int meshIndex = 0; meshIndex < numMeshes; meshIndex++) {
+                error = std::max(error, std::abs(streamed(meshIndex, point) - expected[meshIndex]) / scale);
+            }
+        }
+        // The second run may hand a point to another worker, so compare with a tolerance
+        bool collectedMatches = (collected - streamed).cwiseAbs().maxCoeff() < tolerance * streamed.cwiseAbs().maxCoeff();
+
+        std::cout << width << "x" << width << " grid, " << numPoints << " points: relative error " << error
+                  << (collectedMatches ? "" : ", collected currents differ from the stream") << std::endl;
+        if (!(error < tolerance) || !collectedMatches) {
+            failures++;
+        }
+    }
+
+    if (failures > 0) {
+        std::cout << "FrequencySweepTest failed!" << std::endl;
+        return 1;
+    }
+    std::cout << "FrequencySweepTest passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,143 @@
+// Test includes
+#include "load/LoadTable.hpp"
+// General C++ includes
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Enough rows to fill every small chunk and end part way into a full one, on a
+// row count that is not a multiple of either vector width
+static const int NUM_ROWS = 1101;
+
+// Batches of ids passed to setCurrents, each exercising another split into runs
+static std::vector<std::vector<int>> buildBatches(std::mt19937& generator) {
+    std::vector<std::vector<int>> batches;
+
+    // Every id in order, one run per chunk
+    std::vector<int> all(NUM_ROWS);
+    for (int id = 0; id < NUM_ROWS; id++) {
+        all[id] = id;
+    }
+    batches.push_back(all);
+
+    // Runs of 1 to 17 ids separated by gaps, so that runs start at every offset
+    // from a vector boundary and end on every tail length, some crossing a chunk boundary
+    std::vector<int> runs;
+    for (int id = 3, length = 1; id < NUM_ROWS; length = length % 17 + 1) {
+        for (int row = 0; row < length && id < NUM_ROWS; row++) {
+            runs.push_back(id++);
+        }
+        id += length % 3 + 1;
+    }
+    batches.push_back(runs);
+
+    // Descending and shuffled ids, which never form a run longer than one
+    std::vector<int> descending(all.rbegin(), all.rend());
+    batches.push_back(descending);
+    std::vector<int> shuffled(all.begin(), all.begin() + NUM_ROWS / 2);
+    std::shuffle(shuffled.begin(), shuffled.end(), generator);
+    batches.push_back(shuffled);
+    return batches;
+}
+
+// Largest difference between the voltages and powers of two tables relative to the largest value
+static double maxRelativeError(const LoadTable& actual, const LoadTable& expected) {
+    double scale = 0.0;
+    double error = 0.0;
+    for (int id = 0; id < NUM_ROWS; id++) {
+        scale = std::max({scale, std::abs(expected.getVoltage(id)), std::abs(expected.getComplexPower(id))});
+        error = std::max({error, std::abs(actual.getVoltage(id) - expected.getVoltage(id)),
+                          std::abs(actual.getComplexPower(id) - expected.getComplexPower(id))});
+    }
+    return error / scale;
+}
+
+// Largest difference between the voltages and powers of a table and V = Z * I, S = V * conj(I)
+static double maxRelativeError(const LoadTable& table) {
+    double scale = 0.0;
+    double error = 0.0;
+    for (int id = 0; id < NUM_ROWS; id++) {
+        std::complex<double> voltage = table.getImpedance(id) * table.getCurrent(id);
+        std::complex<double> power = voltage * std::conj(table.getCurrent(id));
+        scale = std::max({scale, std::abs(voltage), std::abs(power)});
+        error = std::max({error, std::abs(table.getVoltage(id) - voltage),
+                          std::abs(table.getComplexPower(id) - power)});
+    }
+    return error / scale;
+}
+
+// Every kernel the CPU supports against the scalar one, fed the same impedances
+// and the same batches of currents: ids in order across chunk boundaries, short
+// runs on every tail length, and ids that form no run at all. The scalar table
+// itself is checked against complex arithmetic.
+int main() {
+    const double tolerance = 1e-14;
+    int failures = 0;
+
+    LoadTable::Kernel kernels[] = {LoadTable::Kernel::SCALAR, LoadTable::Kernel::AVX2, LoadTable::Kernel::AVX512};
+    const char* names[] = {"scalar", "AVX2", "AVX-512"};
+    std::vector<std::unique_ptr<LoadTable>> tables;
+    for (LoadTable::Kernel kernel : kernels) {
+        tables.push_back(std::make_unique<LoadTable>());
+        if (LoadTable::isSupported(kernel)) {
+            tables.back()->setKernel(kernel);
+        } else {
+            tables.back().reset();
+        }
+    }
+    LoadTable automatic;
+    if (automatic.getKernel() == LoadTable::Kernel::AUTO || !LoadTable::isSupported(automatic.getKernel())) {
+        std::cout << "automatic kernel not resolved to a supported one" << std::endl;
+        failures++;
+    }
+
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> value(-10.0, 10.0);
+    for (int id = 0; id < NUM_ROWS; id++) {
+        std::complex<double> impedance(std::abs(value(generator)) + 0.1, value(generator));
+        for (const std::unique_ptr<LoadTable>& table : tables) {
+            if (table != nullptr) {
+                table->allocate();
+                table->setImpedance(id, impedance);
+            }
+        }
+    }
+
+    std::vector<std::vector<int>> batches = buildBatches(generator);
+    const char* batchNames[] = {"ids in order", "runs of 1 to 17 ids", "descending ids", "shuffled ids"};
+    for (size_t batch = 0; batch < batches.size(); ++batch) {
+        const std::vector<int>& ids = batches[batch];
+        std::vector<std::complex<double>> currents(ids.size());
+        for (std::complex<double>& current : currents) {
+            current = {value(generator), value(generator)};
+        }
+
+        for (size_t kernel = 0; kernel < tables.size(); ++kernel) {
+            if (tables[kernel] == nullptr) {
+                continue;
+            }
+            tables[kernel]->setCurrents(ids.data(), currents.data(), ids.size());
+            double error = kernel == 0 ? maxRelativeError(*tables[0]) : maxRelativeError(*tables[kernel], *tables[0]);
+            std::cout << names[kernel] << ", " << batchNames[batch] << ": relative error " << error << std::endl;
+            if (!(error < tolerance)) {
+                failures++;
+            }
+        }
+    }
+    for (size_t kernel = 1; kernel < tables.size(); ++kernel) {
+        if (tables[kernel] == nullptr) {
+            std::cout << names[kernel] << " not supported by this CPU, skipped" << std::endl;
+        }
+    }
+
+    if (failures > 0) {
+        std::cout << "LoadTableTest failed!" << std::endl;
+        return 1;
+    }
+    std::cout << "LoadTableTest passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,110 @@
+// Test includes
+#include "TestCircuits.hpp"
+#include "constants/Constants.hpp"
+// General C++ includes
+#include <algorithm>
+#include <complex>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Rank of the low-rank terms on top of the factorization of the first block
+static int getUpdateRank(const Circuit& circuit) {
+    return circuit.isRealBlock(0) ? circuit.getRealBlockSolver(0).getUpdateRank()
+                                  : circuit.getBlockSolver(0).getUpdateRank();
+}
+
+// Change one load at a time through updateLoadImpedance on one copy of a grid and
+// through a QR refactor on another, over a chain of updates long enough to go
+// through several resets of the low-rank terms. Every few steps the same load
+// changes again, so updates of one load accumulate. Returns the largest mesh
+// current difference relative to the largest current.
+static double maxRelativeError(int width, bool resistive, int numUpdates, int& maxRank, int& numResets) {
+    CircuitBuilder updatedBuilder;
+    CircuitBuilder referenceBuilder;
+    Circuit* updated = buildGrid(updatedBuilder, width);
+    Circuit* reference = buildGrid(referenceBuilder, width);
+    reference->setSolverMode(SolverKind::DENSE_QR);
+    const LoadIncidence& updatedLoads = updated->getLoadIncidence();
+    const LoadIncidence& referenceLoads = reference->getLoadIncidence();
+    int numLoads = updatedLoads.getNumLoads();
+    if (resistive) {
+        for (int loadIndex = 0; loadIndex < numLoads; loadIndex++) {
+            double resistance = std::abs(updatedLoads.getLoad(loadIndex)->getImpedance());
+            updatedLoads.getLoad(loadIndex)->setImpedance(resistance);
+            referenceLoads.getLoad(loadIndex)->setImpedance(resistance);
+        }
+    }
+    updated->solveMeshCurrents();
+
+    std::mt19937 engine(12345);
+    std::uniform_int_distribution<int> pickLoad(0, numLoads - 1);
+    std::uniform_real_distribution<double> pickScale(0.5, 2.0);
+    std::uniform_real_distribution<double> pickAngle(-0.5, 0.5);
+    int loadIndex = 0;
+    int previousRank = 0;
+    double error = 0.0;
+    for (int step = 0; step < numUpdates; step++) {
+        if (step % 5 != 4) {
+            loadIndex = pickLoad(engine);
+        }
+        std::complex<double> impedance = updatedLoads.getLoad(loadIndex)->getImpedance() * pickScale(engine);
+        if (!resistive) {
+            impedance *= std::polar(1.0, pickAngle(engine));
+        }
+
+        updated->updateLoadImpedance(updatedLoads.getLoad(loadIndex), impedance);
+        referenceLoads.getLoad(loadIndex)->setImpedance(impedance);
+        reference->solveMeshCurrents();
+
+        std::vector<std::complex<double>> actual = updated->getMeshCurrents();
+        std::vector<std::complex<double>> expected = reference->getMeshCurrents();
+        double scale = 0.0;
+        for (const std::complex<double>& current : expected) {
+            scale = std::max(scale, std::abs(current));
+        }
+        for (size_t meshIndex = 0; meshIndex < expected.size(); ++meshIndex) {
+            error = std::max(error, std::abs(actual[meshIndex] - expected[meshIndex]) / scale);
+        }
+
+        int rank = getUpdateRank(*updated);
+        maxRank = std::max(maxRank, rank);
+        numResets += rank < previousRank;
+        previousRank = rank;
+    }
+    return error;
+}
+
+// Low-rank re-solves against a forced refactor on grids solved by the dense
+// factorizations and by sparse LU, in complex and in real arithmetic
+int main() {
+    const double tolerance = 1e-9;
+    const int numUpdates = 3 * MAX_LOW_RANK_UPDATES + 5;
+    int failures = 0;
+
+    for (int width : {6, 12}) {
+        for (bool resistive : {false, true}) {
+            int maxRank = 0;
+            int numResets = 0;
+            double error = maxRelativeError(width, resistive, numUpdates, maxRank, numResets);
+            std::cout << width << "x" << width << (resistive ? " resistive" : "") << " grid, " << numUpdates
+                      << " updates: relative error " << error << ", largest rank " << maxRank
+                      << ", resets " << numResets << std::endl;
+            if (!(error < tolerance)) {
+                failures++;
+            }
+            // The terms must build up to the limit and be folded into a refactor each time
+            if (maxRank != MAX_LOW_RANK_UPDATES || numResets < 2) {
+                std::cout << "Low-rank terms did not accumulate and reset" << std::endl;
+                failures++;
+            }
+        }
+    }
+
+    if (failures > 0) {
+        std::cout << "LowRankUpdateTest failed!" << std::endl;
+        return 1;
+    }
+    std::cout << "LowRankUpdateTest passed" << std::endl;
+    return 0;
+}
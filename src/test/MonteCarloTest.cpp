@@ -0,0 +1,134 @@
+// Test includes
+#include "TestCircuits.hpp"
+#include "analysis/MonteCarloAnalysis.hpp"
+#include "load/components/Resistor.hpp"
+#include "sources/DC/DCVoltageSource.hpp"
+// General C++ includes
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// Largest relative difference between the statistics of two runs; the
+// histograms, counts and extremes must match exactly
+static double maxRelativeDifference(const std::vector<MonteCarloAnalysis::LoadStatistics>& first,
+                                    const std::vector<MonteCarloAnalysis::LoadStatistics>& second) {
+    if (first.size() != second.size()) {
+        return INFINITY;
+    }
+    auto relative = [](double a, double b) {
+        return std::abs(a - b) / std::max(std::abs(a), std::abs(b));
+    };
+    double difference = 0.0;
+    for (size_t loadIndex = 0; loadIndex < first.size(); ++loadIndex) {
+        const MonteCarloAnalysis::LoadStatistics& a = first[loadIndex];
+        const MonteCarloAnalysis::LoadStatistics& b = second[loadIndex];
+        if (a.current.getCount() != b.current.getCount()
+            || a.current.getMinimum() != b.current.getMinimum() || a.current.getMaximum() != b.current.getMaximum()
+            || a.currentHistogram.getCounts() != b.currentHistogram.getCounts()
+            || a.powerHistogram.getCounts() != b.powerHistogram.getCounts()) {
+            return INFINITY;
+        }
+        difference = std::max(difference, relative(a.current.getMean(), b.current.getMean()));
+        difference = std::max(difference, relative(a.current.getVariance(), b.current.getVariance()));
+        difference = std::max(difference, relative(a.power.getMean(), b.power.getMean()));
+        difference = std::max(difference, relative(a.power.getVariance(), b.power.getVariance()));
+    }
+    return difference;
+}
+
+// Sample mean and variance of the current and power of a single resistor
+// with a uniform tolerance against their analytic values, and the same
+// statistics from any number of workers with a fixed seed
+int main() {
+    int failures = 0;
+    auto check = [&](const char* name, double error, double tolerance) {
+        std::cout << name << ": relative error " << error << std::endl;
+        if (!(error < tolerance)) {
+            failures++;
+        }
+    };
+
+    {
+        // I = V / (R (1 + t u)) and P = V^2 / (R (1 + t u)) with u uniform in [-1, 1]:
+        // E[1 / (1 + t u)] = ln((1 + t) / (1 - t)) / (2 t) and E[1 / (1 + t u)^2] = 1 / (1 - t^2)
+        const double voltage = 12.0;
+        const double resistance = 6.0;
+        const double tolerance = 0.1;
+        const long long numSamples = 200000;
+        CircuitBuilder builder;
+        Mesh* mesh = builder.addMesh();
+        Resistor* resistor = builder.addLoad<Resistor>(resistance);
+        resistor->setTolerance(tolerance);
+        mesh->addLoad(resistor);
+        mesh->addSource(builder.addSource<DCVoltageSource>(voltage));
+        Circuit* circuit = builder.getCircuit();
+
+        MonteCarloAnalysis analysis(circuit, numSamples, 42);
+        analysis.run();
+        const MonteCarloAnalysis::LoadStatistics& statistics = analysis.getStatistics(resistor);
+
+        double firstMoment = std::log((1 + tolerance) / (1 - tolerance)) / (2 * tolerance);
+        double secondMoment = 1 / (1 - tolerance * tolerance);
+        double nominalCurrent = voltage / resistance;
+        double nominalPower = voltage * voltage / resistance;
+        double currentMean = nominalCurrent * firstMoment;
+        double currentVariance = nominalCurrent * nominalCurrent * (secondMoment - firstMoment * firstMoment);
+        double powerMean = nominalPower * firstMoment;
+        double powerVariance = nominalPower * nominalPower * (secondMoment - firstMoment * firstMoment);
+
+        // Five standard errors of the sample mean, and a 1% band for the sample variance
+        double meanTolerance = 5 * std::sqrt(currentVariance / numSamples) / currentMean;
+        check("current mean", std::abs(statistics.current.getMean() - currentMean) / currentMean, meanTolerance);
+        check("current variance", std::abs(statistics.current.getVariance() - currentVariance) / currentVariance, 0.01);
+        check("power mean", std::abs(statistics.power.getMean() - powerMean) / powerMean, meanTolerance);
+        check("power variance", std::abs(statistics.power.getVariance() - powerVariance) / powerVariance, 0.01);
+        if (statistics.current.getCount() != numSamples
+            || statistics.current.getMinimum() < nominalCurrent / (1 + tolerance)
+            || statistics.current.getMaximum() > nominalCurrent / (1 - tolerance)) {
+            std::cout << "Current samples outside the tolerance band" << std::endl;
+            failures++;
+        }
+    }
+
+    {
+        // Two meshes sharing a resistor, every resistor varying
+        CircuitBuilder builder;
+        Mesh* first = builder.addMesh();
+        Mesh* second = builder.addMesh();
+        std::vector<Resistor*> resistors;
+        for (double resistance : {5.0, 7.0, 11.0}) {
+            resistors.push_back(builder.addLoad<Resistor>(resistance));
+            resistors.back()->setTolerance(0.05);
+        }
+        first->addLoad(resistors[0]);
+        first->addLoad(resistors[1]);
+        second->addLoad(resistors[1]);
+        second->addLoad(resistors[2]);
+        first->addSource(builder.addSource<DCVoltageSource>(10.0));
+        second->addSource(builder.addSource<DCVoltageSource>(-4.0));
+        Circuit* circuit = builder.getCircuit();
+
+        std::vector<std::vector<MonteCarloAnalysis::LoadStatistics>> runs;
+        for (int numThreads : {1, 3, 8}) {
+            for (MonteCarloAnalysis::Distribution distribution : {MonteCarloAnalysis::Distribution::UNIFORM,
+                                                                  MonteCarloAnalysis::Distribution::GAUSSIAN}) {
+                MonteCarloAnalysis analysis(circuit, 20000, 7);
+                analysis.setDistribution(distribution);
+                analysis.setNumThreads(numThreads);
+                analysis.run();
+                runs.push_back(analysis.getStatistics());
+            }
+        }
+        for (size_t run = 2; run < runs.size(); ++run) {
+            check("statistics against a single worker", maxRelativeDifference(runs[run % 2], runs[run]), 1e-12);
+        }
+    }
+
+    if (failures > 0) {
+        std::cout << "MonteCarloTest failed!" << std::endl;
+        return 1;
+    }
+    std::cout << "MonteCarloTest passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,106 @@
+// Test includes
+#include "TestCircuits.hpp"
+#include "analysis/ParameterSweep.hpp"
+#include "constants/Constants.hpp"
+#include "load/components/Capacitor.hpp"
+#include "load/components/Inductor.hpp"
+#include "load/components/Resistor.hpp"
+// General C++ includes
+#include <algorithm>
+#include <complex>
+#include <iostream>
+#include <vector>
+
+// Largest difference between the mesh currents of every sweep point and a
+// point by point solve with the components set to the values of the point,
+// relative to the largest current
+static double maxRelativeError(Circuit& circuit, ParameterSweep& sweep, const std::vector<Component*>& components) {
+    sweep.run();
+    const Eigen::MatrixXd& values = sweep.getParameterValues();
+    const Eigen::MatrixXcd& currents = sweep.getMeshCurrents();
+
+    std::vector<double> nominal;
+    for (Component* component : components) {
+        nominal.push_back(component->getComponentValue());
+    }
+
+    double scale = currents.cwiseAbs().maxCoeff();
+    double error = 0.0;
+    for (int point = 0; point < sweep.getNumPoints(); point++) {
+        for (size_t parameterIndex = 0; parameterIndex < components.size(); ++parameterIndex) {
+            components[parameterIndex]->setComponentValue(values(point, parameterIndex));
+        }
+        circuit.solveMeshCurrents();
+        std::vector<std::complex<double>> expected = circuit.getMeshCurrents();
+        for (size_t meshIndex = 0; meshIndex < expected.size(); ++meshIndex) {
+            error = std::max(error, std::abs(currents(point, meshIndex) - expected[meshIndex]) / scale);
+        }
+    }
+
+    for (size_t parameterIndex = 0; parameterIndex < components.size(); ++parameterIndex) {
+        components[parameterIndex]->setComponentValue(nominal[parameterIndex]);
+    }
+    return error;
+}
+
+// Cartesian and zipped sweeps of a resistor, an inductor and a capacitor in
+// a three-mesh AC circuit against setting the values and solving point by point
+int main() {
+    const double tolerance = 1e-12;
+    int failures = 0;
+    auto report = [&](const char* name, double error) {
+        std::cout << name << ": relative error " << error << std::endl;
+        if (!(error < tolerance)) {
+            failures++;
+        }
+    };
+
+    const double angularFrequency = 2 * PI * 60.0;
+    CircuitBuilder builder;
+    Mesh* first = builder.addMesh();
+    Mesh* second = builder.addMesh();
+    Mesh* third = builder.addMesh();
+    Resistor* resistor = builder.addLoad<Resistor>(10.0);
+    Inductor* inductor = builder.addLoad<Inductor>(0.05, angularFrequency);
+    Capacitor* capacitor = builder.addLoad<Capacitor>(1e-4, angularFrequency);
+    first->addSource(builder.addSource<ACVoltageSource>(20.0, 30.0, 60.0));
+    first->addLoad(resistor);
+    first->addLoad(inductor);
+    second->addLoad(inductor);
+    second->addLoad(capacitor);
+    second->addLoad(builder.addLoad<Resistor>(4.0));
+    third->addLoad(capacitor);
+    third->addLoad(builder.addLoad<Resistor>(8.0));
+    third->addSource(builder.addSource<ACVoltageSource>(5.0, -45.0, 60.0));
+    Circuit* circuit = builder.getCircuit();
+
+    {
+        ParameterSweep sweep(circuit, ParameterSweep::Combination::CARTESIAN);
+        sweep.addLinearParameter(resistor, 1.0, 100.0, 4);
+        sweep.addLogParameter(inductor, 1e-3, 1e-1, 3);
+        sweep.addParameter(capacitor, {1e-5, 1e-3});
+        if (sweep.getNumPoints() != 24) {
+            std::cout << "Cartesian sweep has " << sweep.getNumPoints() << " points instead of 24" << std::endl;
+            failures++;
+        }
+        report("Cartesian sweep", maxRelativeError(*circuit, sweep, {resistor, inductor, capacitor}));
+    }
+
+    {
+        ParameterSweep sweep(circuit, ParameterSweep::Combination::ZIP);
+        sweep.addLinearParameter(resistor, 1.0, 100.0, 5);
+        sweep.addLogParameter(capacitor, 1e-6, 1e-2, 5);
+        if (sweep.getNumPoints() != 5) {
+            std::cout << "Zipped sweep has " << sweep.getNumPoints() << " points instead of 5" << std::endl;
+            failures++;
+        }
+        report("zipped sweep", maxRelativeError(*circuit, sweep, {resistor, capacitor}));
+    }
+
+    if (failures > 0) {
+        std::cout << "ParameterSweepTest failed!" << std::endl;
+        return 1;
+    }
+    std::cout << "ParameterSweepTest passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,120 @@
+// Test includes
+#include "TestCircuits.hpp"
+#include "load/components/Resistor.hpp"
+#include "sources/DC/DCCurrentSource.hpp"
+#include "sources/DC/DCVoltageSource.hpp"
+// General C++ includes
+#include <algorithm>
+#include <complex>
+#include <iostream>
+#include <vector>
+
+// Mesh current, or the branch current of a load the way a simulation reports
+// it: its last mesh minus its first when it is shared
+static std::complex<double> solveOutput(Circuit& circuit, int meshIndex, Load* load) {
+    circuit.solveMeshCurrents();
+    std::vector<std::complex<double>> currents = circuit.getMeshCurrents();
+    if (load == nullptr) {
+        return currents[meshIndex];
+    }
+    const LoadIncidence& incidence = circuit.getLoadIncidence();
+    int loadIndex = incidence.findLoad(load);
+    const int* meshes = incidence.meshesBegin(loadIndex);
+    int meshCount = incidence.meshesEnd(loadIndex) - meshes;
+    if (meshCount == 2 && meshes[0] != meshes[1]) {
+        return currents[meshes[1]] - currents[meshes[0]];
+    }
+    return currents[meshes[0]];
+}
+
+// Largest difference between the adjoint sensitivities and central finite
+// differences over a sample of loads, relative to the largest sensitivity
+static double maxRelativeError(Circuit& circuit, int meshIndex, Load* load) {
+    circuit.solveMeshCurrents();
+    std::vector<std::complex<double>> sensitivities = load == nullptr
+        ? circuit.getMeshCurrentSensitivities(meshIndex)
+        : circuit.getLoadCurrentSensitivities(load);
+
+    double scale = 0.0;
+    for (const std::complex<double>& sensitivity : sensitivities) {
+        scale = std::max(scale, std::abs(sensitivity));
+    }
+
+    const LoadIncidence& incidence = circuit.getLoadIncidence();
+    int numLoads = incidence.getNumLoads();
+    double error = 0.0;
+    for (int loadIndex = 0; loadIndex < numLoads; loadIndex += std::max(1, numLoads / 40)) {
+        Load* varied = incidence.getLoad(loadIndex);
+        std::complex<double> impedance = varied->getImpedance();
+        double step = 1e-6 * std::abs(impedance);
+        varied->setImpedance(impedance + step);
+        std::complex<double> above = solveOutput(circuit, meshIndex, load);
+        varied->setImpedance(impedance - step);
+        std::complex<double> below = solveOutput(circuit, meshIndex, load);
+        varied->setImpedance(impedance);
+
+        std::complex<double> difference = (above - below) / (2.0 * step);
+        error = std::max(error, std::abs(difference - sensitivities[loadIndex]) / scale);
+    }
+    return error;
+}
+
+// Mesh and load current sensitivities against central finite differences on
+// a sparse grid, a block small enough for the fixed-size kernels, and a
+// resistive block with a current source, solved in real arithmetic
+int main() {
+    const double tolerance = 1e-6;
+    int failures = 0;
+    auto report = [&](const char* name, double error) {
+        std::cout << name << ": relative error " << error << std::endl;
+        if (!(error < tolerance)) {
+            failures++;
+        }
+    };
+
+    {
+        CircuitBuilder builder;
+        Circuit* circuit = buildGrid(builder, 20);
+        report("20x20 grid, mesh current", maxRelativeError(*circuit, 37, nullptr));
+        // The second load of the first mesh is shared with its right neighbour
+        Load* shared = circuit->getMeshesView()[0]->getLoadsView()[1];
+        report("20x20 grid, shared load current", maxRelativeError(*circuit, 0, shared));
+    }
+
+    {
+        CircuitBuilder builder;
+        Circuit* circuit = buildGrid(builder, 2);
+        report("2x2 grid, mesh current", maxRelativeError(*circuit, 1, nullptr));
+    }
+
+    {
+        CircuitBuilder builder;
+        Mesh* first = builder.addMesh();
+        Mesh* second = builder.addMesh();
+        Mesh* third = builder.addMesh();
+        Load* shared = builder.addLoad<Resistor>(7.0);
+        first->addLoad(builder.addLoad<Resistor>(5.0));
+        first->addLoad(shared);
+        first->addSource(builder.addSource<DCVoltageSource>(10.0));
+        second->addLoad(shared);
+        second->addLoad(builder.addLoad<Resistor>(11.0));
+        third->addLoad(builder.addLoad<Resistor>(2.0));
+        Source* currentSource = builder.addSource<DCCurrentSource>(0.5);
+        second->addSource(currentSource);
+        third->addSource(currentSource);
+        Circuit* circuit = builder.getCircuit();
+        circuit->solveMeshCurrents();
+        if (!circuit->isRealBlock(0)) {
+            std::cout << "Resistive block not solved in real arithmetic" << std::endl;
+            failures++;
+        }
+        report("resistive block with a current source, shared load current", maxRelativeError(*circuit, 0, shared));
+    }
+
+    if (failures > 0) {
+        std::cout << "SensitivityTest failed!" << std::endl;
+        return 1;
+    }
+    std::cout << "SensitivityTest passed" << std::endl;
+    return 0;
+}
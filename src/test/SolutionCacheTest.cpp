@@ -0,0 +1,102 @@
+// Test includes
+#include "TestCircuits.hpp"
+#include "circuit/CircuitHash.hpp"
+#include "simulator/Simulator.hpp"
+#include "simulator/SolutionCache.hpp"
+// General C++ includes
+#include <complex>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+// Simulations of identical circuits share one solution, a changed impedance
+// misses, and the cache itself evicts the least recently used entries under
+// its byte cap and never takes a colliding key for a match
+int main() {
+    int failures = 0;
+    auto expect = [&](const char* name, bool condition) {
+        if (!condition) {
+            std::cout << name << " failed" << std::endl;
+            failures++;
+        }
+    };
+
+    {
+        SolutionCache cache(1 << 20);
+        CircuitBuilder builder;
+        Circuit* circuit = buildGrid(builder, 4);
+        Simulator simulator(circuit);
+        simulator.setSolutionCache(&cache);
+
+        simulator.runSimulation();
+        std::vector<std::complex<double>> solved = circuit->getMeshCurrents();
+        expect("first run misses", cache.getHits() == 0 && cache.getMisses() == 1 && cache.getSize() == 1);
+        simulator.runSimulation();
+        expect("second run hits", cache.getHits() == 1 && cache.getMisses() == 1);
+        expect("hit restores the mesh currents", circuit->getMeshCurrents() == solved);
+
+        // Another circuit built the same way hashes equal
+        CircuitBuilder otherBuilder;
+        Circuit* other = buildGrid(otherBuilder, 4);
+        Simulator otherSimulator(other);
+        otherSimulator.setSolutionCache(&cache);
+        otherSimulator.runSimulation();
+        expect("identical circuit hits", cache.getHits() == 2 && cache.getMisses() == 1);
+        expect("identical circuit gets the mesh currents", other->getMeshCurrents() == solved);
+
+        Load* load = circuit->getMeshesView()[5]->getLoadsView()[0];
+        std::complex<double> impedance = load->getImpedance();
+        load->setImpedance(impedance * 1.5);
+        simulator.runSimulation();
+        expect("changed impedance misses", cache.getHits() == 2 && cache.getMisses() == 2 && cache.getSize() == 2);
+        load->setImpedance(impedance);
+        simulator.runSimulation();
+        expect("restored impedance hits", cache.getHits() == 3 && cache.getMisses() == 2);
+    }
+
+    {
+        std::vector<std::complex<double>> meshCurrents(10, 1.0);
+        std::vector<std::complex<double>> loadCurrents(20, 2.0);
+        std::vector<std::complex<double>> meshOut;
+        std::vector<std::complex<double>> loadOut;
+        auto key = [](std::uint64_t hash, std::uint64_t check) {
+            return CircuitHash::Key{hash, check, 10, 20};
+        };
+
+        // Room for two entries
+        SolutionCache probe(1 << 20);
+        probe.insert(key(1, 1), meshCurrents, loadCurrents);
+        std::size_t entryBytes = probe.getUsedBytes();
+        SolutionCache cache(2 * entryBytes + entryBytes / 2);
+
+        cache.insert(key(1, 1), meshCurrents, loadCurrents);
+        cache.insert(key(2, 2), meshCurrents, loadCurrents);
+        expect("lookup of the first entry", cache.lookup(key(1, 1), meshOut, loadOut));
+        expect("lookup copies the currents", meshOut == meshCurrents && loadOut == loadCurrents);
+        cache.insert(key(3, 3), meshCurrents, loadCurrents);
+        expect("cap holds two entries", cache.getSize() == 2 && cache.getUsedBytes() <= cache.getCapacityBytes());
+        expect("least recently used entry is evicted", !cache.lookup(key(2, 2), meshOut, loadOut));
+        expect("recently used entry is kept", cache.lookup(key(1, 1), meshOut, loadOut));
+        expect("newest entry is kept", cache.lookup(key(3, 3), meshOut, loadOut));
+
+        // Same first hash with another check hash or other sizes is a collision
+        std::size_t misses = cache.getMisses();
+        expect("colliding check hash misses", !cache.lookup(key(3, 4), meshOut, loadOut));
+        expect("colliding sizes miss", !cache.lookup(CircuitHash::Key{3, 3, 11, 20}, meshOut, loadOut));
+        expect("collisions count as misses", cache.getMisses() == misses + 2);
+        cache.insert(key(3, 4), meshCurrents, loadCurrents);
+        expect("colliding insert replaces the entry", cache.getSize() == 2 && !cache.lookup(key(3, 3), meshOut, loadOut)
+                                                      && cache.lookup(key(3, 4), meshOut, loadOut));
+
+        SolutionCache tiny(entryBytes - 1);
+        tiny.insert(key(1, 1), meshCurrents, loadCurrents);
+        expect("entry larger than the cap is not stored", tiny.getSize() == 0 && tiny.getUsedBytes() == 0);
+    }
+
+    if (failures > 0) {
+        std::cout << "SolutionCacheTest failed!" << std::endl;
+        return 1;
+    }
+    std::cout << "SolutionCacheTest passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,181 @@
+// Test includes
+#include "TestCircuits.hpp"
+#include "analysis/SuperpositionAnalysis.hpp"
+#include "constants/Constants.hpp"
+#include "load/components/Capacitor.hpp"
+#include "load/components/Resistor.hpp"
+#include "sources/DC/DCCurrentSource.hpp"
+#include "sources/DC/DCVoltageSource.hpp"
+// General C++ includes
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+// Capacitors blocking DC in the corner of the grid
+enum class Capacitors {
+    // Two in series in the last mesh
+    SERIES,
+    // One in the second to last mesh, one shared with the last mesh and one in the last mesh
+    CUT_SET
+};
+
+// Sources of a network: both, or those of one frequency for a reference solve
+enum class Sources {
+    BOTH,
+    // The DC source, with the capacitors left out and a zero current source in every
+    // mesh they hold at zero current at DC
+    DC_REFERENCE,
+    // The 60 Hz source and the capacitors
+    AC_REFERENCE
+};
+
+// Square grid of resistors with a DC source in the first mesh, a 60 Hz source in
+// the middle one and capacitors in the last meshes
+static Circuit* buildNetwork(CircuitBuilder& builder, int width, Capacitors capacitors, Sources sources) {
+    const double angularFrequency = 2 * PI * 60.0;
+    std::vector<Mesh*> meshes(width * width);
+    for (Mesh*& mesh : meshes) {
+        mesh = builder.addMesh();
+    }
+    for (int row = 0; row < width; row++) {
+        for (int column = 0; column < width; column++) {
+            Mesh* mesh = meshes[row * width + column];
+            mesh->addLoad(builder.addLoad<Resistor>(10.0 + column + row));
+            if (column + 1 < width) {
+                Resistor* shared = builder.addLoad<Resistor>(3.0);
+                mesh->addLoad(shared);
+                meshes[row * width + column + 1]->addLoad(shared);
+            }
+            if (row + 1 < width) {
+                Resistor* shared = builder.addLoad<Resistor>(4.0);
+                mesh->addLoad(shared);
+                meshes[(row + 1) * width + column]->addLoad(shared);
+            }
+        }
+    }
+    if (sources != Sources::AC_REFERENCE) {
+        meshes.front()->addSource(builder.addSource<DCVoltageSource>(12.0));
+    }
+    if (sources != Sources::DC_REFERENCE) {
+        meshes[meshes.size() / 2]->addSource(builder.addSource<ACVoltageSource>(10.0, 30.0, 60.0));
+    }
+
+    Mesh* last = meshes.back();
+    Mesh* previous = meshes[meshes.size() - 2];
+    if (sources == Sources::DC_REFERENCE) {
+        last->addSource(builder.addSource<DCCurrentSource>(0.0));
+        if (capacitors == Capacitors::CUT_SET) {
+            previous->addSource(builder.addSource<DCCurrentSource>(0.0));
+        }
+    } else if (capacitors == Capacitors::SERIES) {
+        last->addLoad(builder.addLoad<Capacitor>(1e-3, angularFrequency));
+        last->addLoad(builder.addLoad<Capacitor>(2e-3, angularFrequency));
+    } else {
+        Capacitor* shared = builder.addLoad<Capacitor>(2e-3, angularFrequency);
+        previous->addLoad(builder.addLoad<Capacitor>(1e-3, angularFrequency));
+        previous->addLoad(shared);
+        last->addLoad(shared);
+        last->addLoad(builder.addLoad<Capacitor>(3e-3, angularFrequency));
+    }
+    return builder.getCircuit();
+}
+
+// Largest difference between two sets of currents relative to the largest of the expected ones
+template <typename Value>
+static double maxRelativeError(const std::vector<Value>& actual, const std::vector<Value>& expected) {
+    double scale = 0.0;
+    double error = 0.0;
+    for (size_t index = 0; index < expected.size(); ++index) {
+        scale = std::max(scale, std::abs(expected[index]));
+        error = std::max(error, std::abs(actual[index] - expected[index]));
+    }
+    return actual.size() == expected.size() ? error / scale : INFINITY;
+}
+
+// Superposition of a DC and a 60 Hz source on grids whose capacitors open at DC, in
+// series and as a cut set, on the dense and the sparse path. The DC phasors must match
+// the grid with the pinned meshes held at zero current, the 60 Hz phasors the grid
+// solved with only its AC source, and the time-domain sum and the RMS values must be
+// those of the two.
+int main() {
+    const double tolerance = 1e-12;
+    int failures = 0;
+    auto check = [&](const char* name, double error) {
+        std::cout << "  " << name << ": relative error " << error << std::endl;
+        if (!(error < tolerance)) {
+            failures++;
+        }
+    };
+
+    for (int width : {2, 7}) {
+        for (Capacitors capacitors : {Capacitors::SERIES, Capacitors::CUT_SET}) {
+            std::cout << width << "x" << width << " grid, capacitors "
+                      << (capacitors == Capacitors::SERIES ? "in series" : "as a cut set") << std::endl;
+            CircuitBuilder builder;
+            Circuit* circuit = buildNetwork(builder, width, capacitors, Sources::BOTH);
+            SuperpositionAnalysis analysis(circuit);
+            try {
+                analysis.run();
+            } catch (const std::exception& error) {
+                std::cout << "  run failed: " << error.what() << std::endl;
+                failures++;
+                continue;
+            }
+            if (analysis.getFrequencies() != std::vector<double>{0.0, 60.0}) {
+                std::cout << "  frequencies are not DC and 60 Hz" << std::endl;
+                failures++;
+                continue;
+            }
+            const Eigen::MatrixXcd& phasors = analysis.getPhasors();
+            int numMeshes = phasors.rows();
+
+            CircuitBuilder dcBuilder;
+            Circuit* dcCircuit = buildNetwork(dcBuilder, width, capacitors, Sources::DC_REFERENCE);
+            dcCircuit->solveMeshCurrents();
+            std::vector<std::complex<double>> dcCurrents = dcCircuit->getMeshCurrents();
+            CircuitBuilder acBuilder;
+            Circuit* acCircuit = buildNetwork(acBuilder, width, capacitors, Sources::AC_REFERENCE);
+            acCircuit->solveMeshCurrents();
+            std::vector<std::complex<double>> acCurrents = acCircuit->getMeshCurrents();
+
+            std::vector<std::complex<double>> dcPhasors(phasors.col(0).data(), phasors.col(0).data() + numMeshes);
+            std::vector<std::complex<double>> acPhasors(phasors.col(1).data(), phasors.col(1).data() + numMeshes);
+            check("DC phasors", maxRelativeError(dcPhasors, dcCurrents));
+            check("60 Hz phasors", maxRelativeError(acPhasors, acCurrents));
+            double dcScale = phasors.col(0).cwiseAbs().maxCoeff();
+            if (std::abs(phasors(numMeshes - 1, 0)) > tolerance * dcScale
+                || (capacitors == Capacitors::CUT_SET && std::abs(phasors(numMeshes - 2, 0)) > tolerance * dcScale)) {
+                std::cout << "  meshes behind the capacitors carry DC" << std::endl;
+                failures++;
+            }
+
+            // i(t) = I_dc + Re(I_ac e^(jwt)) and rms = sqrt(I_dc^2 + |I_ac|^2 / 2)
+            std::vector<double> expectedRms;
+            for (int meshIndex = 0; meshIndex < numMeshes; meshIndex++) {
+                double dc = dcCurrents[meshIndex].real();
+                expectedRms.push_back(std::sqrt(dc * dc + std::norm(acCurrents[meshIndex]) / 2));
+            }
+            check("RMS currents", maxRelativeError(analysis.getRmsCurrents(), expectedRms));
+            double timeError = 0.0;
+            for (double time : {0.0, 1e-3, 4.2e-3, 1.0 / 60.0}) {
+                std::vector<double> expected;
+                for (int meshIndex = 0; meshIndex < numMeshes; meshIndex++) {
+                    std::complex<double> rotation = std::polar(1.0, 2 * PI * 60.0 * time);
+                    expected.push_back(dcCurrents[meshIndex].real() + (acCurrents[meshIndex] * rotation).real());
+                }
+                timeError = std::max(timeError, maxRelativeError(analysis.getMeshCurrentsAt(time), expected));
+            }
+            check("time-domain currents", timeError);
+        }
+    }
+
+    if (failures > 0) {
+        std::cout << "SuperpositionTest failed!" << std::endl;
+        return 1;
+    }
+    std::cout << "SuperpositionTest passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,39 @@
+#ifndef TESTCIRCUITS_HPP
+#define TESTCIRCUITS_HPP
+
+#include "circuit/Circuit.hpp"
+#include "circuit/CircuitBuilder.hpp"
+#include "sources/AC/ACVoltageSource.hpp"
+#include <vector>
+
+// Square grid of meshes, the shape of the networks the solver thresholds were
+// tuned on: one load per mesh, a load shared with each neighbour, and a
+// source in every third mesh. Shared by the tests and the benchmarks.
+inline Circuit* buildGrid(CircuitBuilder& builder, int width) {
+    std::vector<Mesh*> meshes(width * width);
+    for (Mesh*& mesh : meshes) {
+        mesh = builder.addMesh();
+    }
+    for (int row = 0; row < width; row++) {
+        for (int column = 0; column < width; column++) {
+            Mesh* mesh = meshes[row * width + column];
+            mesh->addLoad(builder.addLoad<Load>(10.0 + column, 5.0 + row));
+            if (column + 1 < width) {
+                Load* shared = builder.addLoad<Load>(3.0, 20.0);
+                mesh->addLoad(shared);
+                meshes[row * width + column + 1]->addLoad(shared);
+            }
+            if (row + 1 < width) {
+                Load* shared = builder.addLoad<Load>(4.0, -20.0);
+                mesh->addLoad(shared);
+                meshes[(row + 1) * width + column]->addLoad(shared);
+            }
+            if ((row + column) % 3 == 0) {
+                mesh->addSource(builder.addSource<ACVoltageSource>(10.0, 10.0 * column, 60.0));
+            }
+        }
+    }
+    return builder.getCircuit();
+}
+
+#endif // TESTCIRCUITS_HPP
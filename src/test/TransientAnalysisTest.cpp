@@ -0,0 +1,104 @@
+// Analysis includes
+#include "analysis/TransientAnalysis.hpp"
+#include "circuit/CircuitBuilder.hpp"
+#include "load/components/Capacitor.hpp"
+#include "load/components/Inductor.hpp"
+#include "load/components/Resistor.hpp"
+#include "sources/DC/DCVoltageSource.hpp"
+// General C++ includes
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+// Largest difference between the simulated current of a single-mesh circuit
+// and the analytic one, relative to the given scale. The circuit is at rest at
+// time zero and the source is on from the first step, which the trapezoidal
+// rule averages into a switch half a step late.
+static double maxRelativeError(Circuit* circuit, IntegrationMethod method, double timeStep, int numSteps,
+                               double scale, const std::function<double(double)>& expected) {
+    Eigen::MatrixXd currents = TransientAnalysis(circuit, timeStep, numSteps, method).run();
+    double delay = method == IntegrationMethod::TRAPEZOIDAL ? timeStep / 2.0 : 0.0;
+    double error = 0.0;
+    for (int step = 1; step <= numSteps; step++) {
+        error = std::max(error, std::abs(currents(0, step) - expected(step * timeStep - delay)) / scale);
+    }
+    return error;
+}
+
+// A DC source switched on at time zero into a series RC and a series RL
+// circuit, against their exponential responses, for both integration
+// methods; and a plain load with a reactance, which has no time-domain model
+int main() {
+    const double voltage = 10.0;
+    const double resistance = 1000.0;
+    const double capacitance = 1e-6;
+    const double inductance = 1.0;
+    const double timeConstant = 1e-3;
+    const double timeStep = 1e-6;
+    const int numSteps = 5000;
+    const IntegrationMethod methods[] = {IntegrationMethod::BACKWARD_EULER, IntegrationMethod::TRAPEZOIDAL};
+    // Backward Euler is first order in the step, the trapezoidal rule second
+    const double tolerances[] = {1e-3, 1e-6};
+    const char* names[] = {"backward Euler", "trapezoidal"};
+    int failures = 0;
+
+    for (int index = 0; index < 2; index++) {
+        // RC charging: i(t) = V / R * exp(-t / RC)
+        {
+            CircuitBuilder builder;
+            Mesh* mesh = builder.addMesh();
+            mesh->addSource(builder.addSource<DCVoltageSource>(voltage));
+            mesh->addLoad(builder.addLoad<Resistor>(resistance));
+            mesh->addLoad(builder.addLoad<Capacitor>(capacitance, 1.0));
+            double error = maxRelativeError(builder.getCircuit(), methods[index], timeStep, numSteps, voltage / resistance,
+                                            [&](double time) { return voltage / resistance * std::exp(-time / timeConstant); });
+            std::cout << "RC, " << names[index] << ": relative error " << error << std::endl;
+            if (!(error < tolerances[index])) {
+                failures++;
+            }
+        }
+
+        // RL energizing: i(t) = V / R * (1 - exp(-t R / L))
+        {
+            CircuitBuilder builder;
+            Mesh* mesh = builder.addMesh();
+            mesh->addSource(builder.addSource<DCVoltageSource>(voltage));
+            mesh->addLoad(builder.addLoad<Resistor>(resistance));
+            mesh->addLoad(builder.addLoad<Inductor>(inductance, 1.0));
+            double error = maxRelativeError(builder.getCircuit(), methods[index], timeStep, numSteps, voltage / resistance,
+                                            [&](double time) { return voltage / resistance * (1.0 - std::exp(-time / timeConstant)); });
+            std::cout << "RL, " << names[index] << ": relative error " << error << std::endl;
+            if (!(error < tolerances[index])) {
+                failures++;
+            }
+        }
+    }
+
+    // A plain load only knows its impedance at one frequency
+    {
+        CircuitBuilder builder;
+        Mesh* mesh = builder.addMesh();
+        mesh->addSource(builder.addSource<DCVoltageSource>(voltage));
+        mesh->addLoad(builder.addLoad<Load>(resistance, 5.0));
+        std::string message;
+        try {
+            TransientAnalysis(builder.getCircuit(), timeStep, 10).run();
+        } catch (const std::runtime_error& error) {
+            message = error.what();
+        }
+        std::cout << "Load with a reactance: \"" << message << "\"" << std::endl;
+        if (message != "Load with a reactance has no transient model!") {
+            failures++;
+        }
+    }
+
+    if (failures > 0) {
+        std::cout << "TransientAnalysisTest failed!" << std::endl;
+        return 1;
+    }
+    std::cout << "TransientAnalysisTest passed" << std::endl;
+    return 0;
+}